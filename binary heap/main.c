@@ -5,32 +5,27 @@
 #include <time.h>
 #include <sys/time.h>
 
-// 图结构定义
-typedef struct Edge {
-    int dest;           // 目标节点
-    int weight;         // 边权重
-    struct Edge* next;  // 下一条边
-} Edge;
+// 图结构 (CSR) 与批量查询引擎与 fib heap 共用
+#include "../fib heap/Graph.h"
+#include "../fib heap/BatchQuery.h"
 
-typedef struct {
-    int num_nodes;      // 节点数量
-    int num_edges;      // 边数量
-    Edge** adj_list;    // 邻接表
-} Graph;
+// Dijkstra 主循环与 test_fib 共用同一组内核模板（fib heap/DijkstraKernel.h），本文件只提供队列
+#include "../fib heap/DijkstraKernel.h"
 
 // 二叉堆节点
 typedef struct {
     int node;           // 节点编号
-    int distance;       // 到源点的距离
+    long long distance; // 到源点的距离
 } HeapNode;
 
-// 二叉堆结构
+// 二叉堆结构（带位置数组，支持 decrease-key）
 typedef struct {
     HeapNode* heap;     // 堆数组
     int* pos;           // 节点在堆中的位置
     int size;           // 当前堆大小
     int capacity;       // 堆容量
-} BinaryHeap;
+    int peak;           // 最近一次查询中堆大小的最大值
+} NodeHeap;
 
 // ==================== 二叉堆操作 ====================
 
@@ -39,12 +34,13 @@ typedef struct {
  * @param capacity 堆容量
  * @return 堆指针
  */
-BinaryHeap* create_heap(int capacity) {
-    BinaryHeap* heap = (BinaryHeap*)malloc(sizeof(BinaryHeap));
+NodeHeap* create_heap(int capacity) {
+    NodeHeap* heap = (NodeHeap*)malloc(sizeof(NodeHeap));
     heap->heap = (HeapNode*)malloc(capacity * sizeof(HeapNode));
     heap->pos = (int*)malloc(capacity * sizeof(int));
     heap->size = 0;
     heap->capacity = capacity;
+    heap->peak = 0;
     
     // 初始化位置数组为-1（表示不在堆中）
     for (int i = 0; i < capacity; i++) {
@@ -58,7 +54,7 @@ BinaryHeap* create_heap(int capacity) {
  * 释放堆内存
  * @param heap 堆指针
  */
-void free_heap(BinaryHeap* heap) {
+void free_heap(NodeHeap* heap) {
     if (heap) {
         free(heap->heap);
         free(heap->pos);
@@ -72,7 +68,7 @@ void free_heap(BinaryHeap* heap) {
  * @param i 第一个位置
  * @param j 第二个位置
  */
-void swap_nodes(BinaryHeap* heap, int i, int j) {
+void swap_nodes(NodeHeap* heap, int i, int j) {
     // 交换堆元素
     HeapNode temp = heap->heap[i];
     heap->heap[i] = heap->heap[j];
@@ -88,7 +84,7 @@ void swap_nodes(BinaryHeap* heap, int i, int j) {
  * @param heap 堆指针
  * @param idx 要上浮的元素位置
  */
-void heapify_up(BinaryHeap* heap, int idx) {
+void heapify_up(NodeHeap* heap, int idx) {
     while (idx > 0) {
         int parent = (idx - 1) / 2;
         if (heap->heap[parent].distance <= heap->heap[idx].distance) {
@@ -104,7 +100,7 @@ void heapify_up(BinaryHeap* heap, int idx) {
  * @param heap 堆指针
  * @param idx 要下沉的元素位置
  */
-void heapify_down(BinaryHeap* heap, int idx) {
+void heapify_down(NodeHeap* heap, int idx) {
     while (2 * idx + 1 < heap->size) {
         int left = 2 * idx + 1;
         int right = 2 * idx + 2;
@@ -132,7 +128,7 @@ void heapify_down(BinaryHeap* heap, int idx) {
  * @param node 节点编号
  * @param distance 距离
  */
-void heap_insert(BinaryHeap* heap, int node, int distance) {
+void heap_insert(NodeHeap* heap, int node, long long distance) {
     if (heap->size >= heap->capacity) {
         printf("Heap overflow!\n");
         return;
@@ -154,9 +150,9 @@ void heap_insert(BinaryHeap* heap, int node, int distance) {
  * @param heap 堆指针
  * @return 最小堆节点
  */
-HeapNode heap_extract_min(BinaryHeap* heap) {
+HeapNode heap_extract_min(NodeHeap* heap) {
     if (heap->size == 0) {
-        HeapNode empty = {-1, INT_MAX};
+        HeapNode empty = {-1, DIJKSTRA_INF};
         return empty;
     }
     
@@ -180,7 +176,7 @@ HeapNode heap_extract_min(BinaryHeap* heap) {
  * @param node 节点编号
  * @param new_distance 新距离
  */
-void heap_decrease_key(BinaryHeap* heap, int node, int new_distance) {
+void heap_decrease_key(NodeHeap* heap, int node, long long new_distance) {
     int idx = heap->pos[node];
     if (idx == -1 || heap->heap[idx].distance <= new_distance) {
         return;
@@ -195,164 +191,344 @@ void heap_decrease_key(BinaryHeap* heap, int node, int new_distance) {
  * @param heap 堆指针
  * @return 1为空，0为非空
  */
-int is_heap_empty(BinaryHeap* heap) {
+int is_heap_empty(NodeHeap* heap) {
     return heap->size == 0;
 }
 
-// ==================== 图操作 ====================
+// ==================== 重复条目堆（无 decrease-key） ====================
+
+// 允许同一节点出现多次的二叉堆：不维护 pos，过期条目在提取时跳过
+typedef struct {
+    HeapNode* heap;     // 堆数组
+    int size;           // 当前堆大小
+    int capacity;       // 当前容量（按需翻倍，跨查询保留）
+    int peak;           // 最近一次查询中堆大小的最大值
+    int stale;          // 最近一次查询中跳过的过期条目数
+    const DijkstraVertexState* state; // 所属查询上下文的顶点状态，用于识别过期条目
+} DupHeap;
 
 /**
- * 创建图
- * @param num_nodes 节点数量
- * @return 图指针
+ * 创建重复条目堆
+ * @param capacity 初始容量
+ * @param state 所属查询上下文的顶点状态
+ * @return 堆指针
  */
-Graph* create_graph(int num_nodes) {
-    Graph* graph = (Graph*)malloc(sizeof(Graph));
-    graph->num_nodes = num_nodes;
-    graph->num_edges = 0;
-    graph->adj_list = (Edge**)calloc(num_nodes, sizeof(Edge*));
-    return graph;
+DupHeap* create_dup_heap(int capacity, const DijkstraVertexState* state) {
+    DupHeap* heap = (DupHeap*)malloc(sizeof(DupHeap));
+    heap->heap = (HeapNode*)malloc(capacity * sizeof(HeapNode));
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->peak = 0;
+    heap->stale = 0;
+    heap->state = state;
+    return heap;
 }
 
 /**
- * 释放图内存
- * @param graph 图指针
+ * 释放重复条目堆
+ * @param heap 堆指针
  */
-void free_graph(Graph* graph) {
-    if (graph) {
-        for (int i = 0; i < graph->num_nodes; i++) {
-            Edge* edge = graph->adj_list[i];
-            while (edge) {
-                Edge* temp = edge;
-                edge = edge->next;
-                free(temp);
-            }
-        }
-        free(graph->adj_list);
-        free(graph);
+void free_dup_heap(DupHeap* heap) {
+    if (heap) {
+        free(heap->heap);
+        free(heap);
     }
 }
 
 /**
- * 添加边到图中
- * @param graph 图指针
- * @param src 源节点
- * @param dest 目标节点
- * @param weight 边权重
+ * 压入条目（空穴法上浮，不更新任何位置信息）
+ * @param heap 堆指针
+ * @param node 节点编号
+ * @param distance 距离
  */
-void add_edge(Graph* graph, int src, int dest, int weight) {
-    // 添加到源节点的邻接表
-    Edge* new_edge = (Edge*)malloc(sizeof(Edge));
-    new_edge->dest = dest;
-    new_edge->weight = weight;
-    new_edge->next = graph->adj_list[src];
-    graph->adj_list[src] = new_edge;
-    graph->num_edges++;
+void dup_heap_push(DupHeap* heap, int node, long long distance) {
+    if (heap->size >= heap->capacity) {
+        int new_capacity = heap->capacity * 2;
+        HeapNode* grown = (HeapNode*)realloc(heap->heap, new_capacity * sizeof(HeapNode));
+        if (!grown) {
+            printf("Heap overflow!\n");
+            return;
+        }
+        heap->heap = grown;
+        heap->capacity = new_capacity;
+    }
+    
+    int idx = heap->size++;
+    while (idx > 0) {
+        int parent = (idx - 1) / 2;
+        if (heap->heap[parent].distance <= distance) {
+            break;
+        }
+        heap->heap[idx] = heap->heap[parent];
+        idx = parent;
+    }
+    heap->heap[idx].node = node;
+    heap->heap[idx].distance = distance;
 }
 
-// ==================== Dijkstra算法 ====================
-
 /**
- * 使用二叉堆的Dijkstra算法
- * @param graph 图指针
- * @param source 源节点
- * @param dist 距离数组（输出）
+ * 弹出最小条目（空穴法下沉）
+ * @param heap 堆指针
+ * @return 最小条目，堆为空时节点为 -1
  */
-void dijkstra_binary_heap(Graph* graph, int source, int* dist) {
-    // 初始化距离数组
-    for (int i = 0; i < graph->num_nodes; i++) {
-        dist[i] = INT_MAX;
-    }
-    dist[source] = 0;
-    
-    // 创建二叉堆
-    BinaryHeap* heap = create_heap(graph->num_nodes);
-    
-    // 将所有节点插入堆中
-    for (int i = 0; i < graph->num_nodes; i++) {
-        heap_insert(heap, i, dist[i]);
+HeapNode dup_heap_pop(DupHeap* heap) {
+    if (heap->size == 0) {
+        HeapNode empty = {-1, DIJKSTRA_INF};
+        return empty;
     }
     
-    // Dijkstra主循环
-    while (!is_heap_empty(heap)) {
-        // 提取距离最小的节点
-        HeapNode min_node = heap_extract_min(heap);
-        int u = min_node.node;
-        
-        // 如果最小距离是无穷大，说明剩余节点不可达
-        if (min_node.distance == INT_MAX) {
-            break;
+    HeapNode min_node = heap->heap[0];
+    HeapNode last = heap->heap[--heap->size];
+    int size = heap->size;
+    int idx = 0;
+    while (2 * idx + 1 < size) {
+        int child = 2 * idx + 1;
+        if (child + 1 < size && heap->heap[child + 1].distance < heap->heap[child].distance) {
+            child++;
         }
-        
-        // 遍历所有邻接边
-        Edge* edge = graph->adj_list[u];
-        while (edge) {
-            int v = edge->dest;
-            int new_dist = dist[u] + edge->weight;
-            
-            // 如果找到更短路径
-            if (new_dist < dist[v]) {
-                dist[v] = new_dist;
-                heap_decrease_key(heap, v, new_dist);
-            }
-            
-            edge = edge->next;
+        if (last.distance <= heap->heap[child].distance) {
+            break;
         }
+        heap->heap[idx] = heap->heap[child];
+        idx = child;
+    }
+    if (size > 0) {
+        heap->heap[idx] = last;
     }
     
-    free_heap(heap);
+    return min_node;
 }
 
-// ==================== 文件读取和测试 ====================
+// ==================== 内核适配（DijkstraKernel.h） ====================
+
+// 以下适配函数把三种堆模式接入 DIJKSTRA_DEFINE_KERNEL / DIJKSTRA_DEFINE_TARGET_SET_KERNEL：
+// 内核负责松弛与停止条件，适配函数只决定堆怎么用。顶点状态由内核维护，这里只有
+// duplicate 模式需要读它（判断过期条目）。
+
+// lazy：清空上次查询留下的不可达节点（只重置它们的位置）
+static inline void lazy_reset(NodeHeap* heap) {
+    for (int i = 0; i < heap->size; i++) {
+        heap->pos[heap->heap[i].node] = -1;
+    }
+    heap->size = 0;
+    heap->peak = 0;
+}
+
+// lazy：首次发现时入堆
+static inline void lazy_push(NodeHeap* heap, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    heap_insert(heap, v, key);
+    if (heap->size > heap->peak) heap->peak = heap->size;
+}
+
+// insert-all：所有节点以无穷大入堆，直接按顺序写入即满足堆性质，无需逐个上浮
+static inline void insert_all_reset(NodeHeap* heap) {
+    for (int i = 0; i < heap->capacity; i++) {
+        heap->heap[i].node = i;
+        heap->heap[i].distance = DIJKSTRA_INF;
+        heap->pos[i] = i;
+    }
+    heap->size = heap->capacity;
+    heap->peak = heap->capacity;
+}
+
+// insert-all：节点已在堆中，首次发现和距离变小都是 decrease-key
+static inline void node_decrease(NodeHeap* heap, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    heap_decrease_key(heap, v, key);
+}
+
+// insert-all：堆顶为无穷大时，剩余节点都不可达
+static inline int insert_all_empty(NodeHeap* heap) {
+    return heap->size == 0 || heap->heap[0].distance == DIJKSTRA_INF;
+}
+
+static inline int node_pop(NodeHeap* heap, DijkstraVertexState* state) {
+    (void)state;
+    return heap_extract_min(heap).node;
+}
+
+static inline void dup_reset(DupHeap* heap) {
+    heap->size = 0;
+    heap->peak = 0;
+    heap->stale = 0;
+}
+
+// duplicate：首次发现和距离变小都压入新条目
+static inline void dup_push(DupHeap* heap, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    dup_heap_push(heap, v, key);
+    if (heap->size > heap->peak) heap->peak = heap->size;
+}
+
+// duplicate：过期条目（该节点之后得到了更短的距离）在判空时丢弃，保证弹出的都是有效条目
+static inline int dup_empty(DupHeap* heap) {
+    while (heap->size > 0 && heap->heap[0].distance > heap->state[heap->heap[0].node].dist) {
+        dup_heap_pop(heap);
+        heap->stale++;
+    }
+    return heap->size == 0;
+}
+
+static inline int dup_pop(DupHeap* heap, DijkstraVertexState* state) {
+    (void)state;
+    return dup_heap_pop(heap).node;
+}
+
+// 三种模式的队列与适配函数：X(MODE, NAME, QUEUE_T, FIELD, RESET, PUSH, DECREASE, POP, EMPTY)
+// FIELD 为 QueryContext 中对应的堆
+#define MODE_QUEUE_LIST(X)                                                                          \
+    X(MODE_INSERT_ALL, insert_all, NodeHeap, heap,                                                  \
+      insert_all_reset, node_decrease, node_decrease, node_pop, insert_all_empty)                  \
+    X(MODE_LAZY, lazy, NodeHeap, heap,                                                              \
+      lazy_reset, lazy_push, node_decrease, node_pop, is_heap_empty)                               \
+    X(MODE_DUPLICATE, duplicate, DupHeap, dup_heap,                                                 \
+      dup_reset, dup_push, dup_push, dup_pop, dup_empty)
+
+// ==================== 查询上下文 ====================
+
+// 堆的使用方式（运行时选择）
+typedef enum {
+    MODE_INSERT_ALL = 0,    // 查询开始时所有节点入堆（距离无穷大），使用 decrease-key
+    MODE_LAZY,              // 节点首次被发现时才入堆，使用 decrease-key
+    MODE_DUPLICATE,         // 不使用 decrease-key：每次改进都压入新条目，提取时跳过过期条目
+    MODE_COUNT
+} DijkstraMode;
+
+static const char* const MODE_NAMES[MODE_COUNT] = { "insert-all", "lazy", "duplicate" };
+
+// 查询上下文（每个线程一个，跨查询复用）
+typedef struct {
+    DijkstraContext* dc;    // 距离、查询编号与目标标记（不带库中的队列，堆由本文件提供）
+    NodeHeap* heap;         // 复用的二叉堆（容量 numVertices + 1），insert-all / lazy 模式
+    DupHeap* dup_heap;      // 复用的重复条目堆，duplicate 模式
+    int heap_peak;          // 最近一次查询中堆大小的最大值
+    int stale_pops;         // 最近一次查询中跳过的过期条目数（duplicate 模式）
+    int settled;            // 最近一次查询确定（出堆）的节点数
+} QueryContext;
 
 /**
- * 读取txt格式的图文件
- * @param filename 文件名
- * @return 图指针
+ * 创建查询上下文
+ * @param graph 图指针
+ * @return 上下文指针，失败时为 NULL
  */
-Graph* read_txt_graph(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        printf("Cannot open file: %s\n", filename);
+QueryContext* create_query_context(Graph* graph) {
+    QueryContext* ctx = (QueryContext*)malloc(sizeof(QueryContext));
+    ctx->dc = createDijkstraContextWithoutQueue(graph);
+    if (!ctx->dc) {
+        free(ctx);
         return NULL;
     }
-    
-    char line[256];
-    int max_node = 0;
-    int edge_count = 0;
-    
-    while (fgets(line, sizeof(line), file)) {
-        int src, dest, weight;
-        if (sscanf(line, "%d %d %d", &src, &dest, &weight) == 3) {
-            edge_count++;
-            if (src > max_node) max_node = src;
-            if (dest > max_node) max_node = dest;
-        }
+    ctx->heap = create_heap(graph->numVertices + 1);
+    ctx->dup_heap = create_dup_heap(graph->numVertices + 1, ctx->dc->state);
+    ctx->heap_peak = 0;
+    ctx->stale_pops = 0;
+    ctx->settled = 0;
+    return ctx;
+}
+
+/**
+ * 释放查询上下文
+ * @param ctx 上下文指针
+ */
+void free_query_context(QueryContext* ctx) {
+    if (ctx) {
+        dijkstraContextDestroy(ctx->dc);
+        free_heap(ctx->heap);
+        free_dup_heap(ctx->dup_heap);
+        free(ctx);
     }
-    
-    if (max_node == 0) {
-        printf("Invalid file format or empty file\n");
-        fclose(file);
-        return NULL;
+}
+
+/**
+ * 读取最近一次查询的距离
+ * @param ctx 上下文指针
+ * @param v 节点编号
+ * @return 距离，不可达时为 DIJKSTRA_INF
+ */
+static inline long long query_get_dist(const QueryContext* ctx, int v) {
+    return dijkstraGetDist(ctx->dc, v);
+}
+
+// ==================== Dijkstra算法 ====================
+
+// 每种模式各一个一对多内核 dijkstra_<模式> 和一个目标集合内核 dijkstra_<模式>_targets
+#define DEFINE_MODE_KERNELS(MODE, NAME, QUEUE_T, FIELD, RESET, PUSH, DECREASE, POP, EMPTY)         \
+    DIJKSTRA_DEFINE_KERNEL(dijkstra_##NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY)             \
+    DIJKSTRA_DEFINE_TARGET_SET_KERNEL(dijkstra_##NAME##_targets, QUEUE_T,                           \
+                                      RESET, PUSH, DECREASE, POP, EMPTY)
+
+MODE_QUEUE_LIST(DEFINE_MODE_KERNELS)
+
+#undef DEFINE_MODE_KERNELS
+
+/**
+ * 记录最近一次查询的统计（确定节点数、堆大小峰值、跳过的过期条目数）
+ */
+static void finish_query(QueryContext* ctx, DijkstraMode mode, int settled) {
+    ctx->settled = settled;
+    ctx->heap_peak = mode == MODE_DUPLICATE ? ctx->dup_heap->peak : ctx->heap->peak;
+    ctx->stale_pops = mode == MODE_DUPLICATE ? ctx->dup_heap->stale : 0;
+}
+
+/**
+ * 使用二叉堆的Dijkstra算法
+ * 结果保存在上下文中，用 query_get_dist 读取；堆大小峰值在 ctx->heap_peak
+ * @param source 源节点
+ * @param ctx 查询上下文（复用堆和距离数组）
+ * @param mode 堆的使用方式
+ */
+void dijkstra_binary_heap(int source, QueryContext* ctx, DijkstraMode mode) {
+    // 惰性初始化：只写源点，其余顶点的距离由 stamp 判定为无穷大
+    int settled = 0;
+    switch (mode) {
+#define RUN_CASE(MODE, NAME, QUEUE_T, FIELD, ...) \
+        case MODE: settled = dijkstra_##NAME(ctx->dc, ctx->FIELD, source, 0); break;
+        MODE_QUEUE_LIST(RUN_CASE)
+#undef RUN_CASE
+        default: break;
     }
-    
-    int num_nodes = max_node;
-    printf("Reading graph: %d nodes, %d edges\n", num_nodes, edge_count);
-    
-    Graph* graph = create_graph(num_nodes);
-    
-    rewind(file);
-    while (fgets(line, sizeof(line), file)) {
-        int src, dest, weight;
-        if (sscanf(line, "%d %d %d", &src, &dest, &weight) == 3) {
-            add_edge(graph, src - 1, dest - 1, weight);
-        }
+    finish_query(ctx, mode, settled);
+}
+
+/**
+ * 目标集合查询：所有终点出堆（距离确定）后立即停止，只返回这些终点的距离
+ * 给出 max_dist 时，出堆距离超过 max_dist 也会停止，更远的终点视为不可达
+ * @param source 源节点
+ * @param targets 终点数组（可以重复）
+ * @param num_targets 终点数
+ * @param max_dist 距离上限，< 0 表示不限
+ * @param ctx 查询上下文
+ * @param mode 堆的使用方式
+ * @param out 输出：out[i] 为到 targets[i] 的距离，不可达或超过上限时为 DIJKSTRA_INF
+ * @return 确定的节点数，节点编号无效时为 -1
+ */
+int dijkstra_binary_heap_targets(int source, const int* targets, int num_targets, long long max_dist,
+                                 QueryContext* ctx, DijkstraMode mode, long long* out) {
+    int remaining = dijkstraBeginTargetSet(ctx->dc, source, targets, num_targets);
+    if (remaining < 0) return -1;
+    if (max_dist < 0) max_dist = DIJKSTRA_INF;
+    
+    int settled = 0;
+    switch (mode) {
+#define TARGETS_CASE(MODE, NAME, QUEUE_T, FIELD, ...) \
+        case MODE: settled = dijkstra_##NAME##_targets(ctx->dc, ctx->FIELD, source, remaining, max_dist); break;
+        MODE_QUEUE_LIST(TARGETS_CASE)
+#undef TARGETS_CASE
+        default: break;
     }
+    finish_query(ctx, mode, settled);
     
-    fclose(file);
-    return graph;
+    // 停止时终点要么已确定，要么距离超过上限（堆已空时暂定距离就是最终距离）
+    for (int i = 0; i < num_targets; i++) {
+        long long d = query_get_dist(ctx, targets[i]);
+        out[i] = d <= max_dist ? d : DIJKSTRA_INF;
+    }
+    return settled;
 }
 
+// ==================== 文件读取和测试 ====================
+
 /**
  * 获取当前时间（微秒）
  * @return 当前时间戳
@@ -363,32 +539,94 @@ long long get_time_us() {
     return (long long)tv.tv_sec * 1000000 + tv.tv_usec;
 }
 
+// ==================== 批量并行查询 ====================
+
+// 批量查询的共享参数
+typedef struct {
+    Graph* graph;
+    DijkstraMode mode;
+} WorkerConfig;
+
+// 批量查询回调：每个工作线程一个查询上下文，图只读共享
+static void* worker_create(void* user_data) {
+    return create_query_context(((WorkerConfig*)user_data)->graph);
+}
+
+static void worker_query(void* worker, int source, void* user_data) {
+    WorkerConfig* cfg = (WorkerConfig*)user_data;
+    dijkstra_binary_heap(source, (QueryContext*)worker, cfg->mode);
+}
+
+static void worker_destroy(void* worker) {
+    free_query_context((QueryContext*)worker);
+}
+
+static const BatchWorkerOps BINARY_WORKER_OPS = {
+    worker_create, worker_query, worker_destroy
+};
+
+/**
+ * 并行性能测试：同一批源点依次用 1, 2, 4, ..., max_threads 个线程执行
+ * @param graph 图指针
+ * @param sources 源点数组
+ * @param num_queries 查询数量
+ * @param max_threads 最大线程数
+ * @param mode 堆的使用方式
+ */
+void parallel_performance_test(Graph* graph, const int* sources, int num_queries, int max_threads,
+                               DijkstraMode mode) {
+    WorkerConfig cfg = { graph, mode };
+    
+    printf("Starting parallel performance test (%d queries, up to %d threads, mode: %s)...\n",
+           num_queries, max_threads, MODE_NAMES[mode]);
+    printf("\n=== Scaling Results ===\n");
+    printf("%8s %12s %14s %10s %12s %10s\n",
+           "Threads", "Time (s)", "Queries/sec", "Speedup", "Efficiency", "Steals");
+    
+    double base_qps = 0.0;
+    for (int t = 1; t != 0; t = batchNextThreadCount(t, max_threads)) {
+        BatchStats stats;
+        if (runBatchQueries(sources, num_queries, t, &BINARY_WORKER_OPS, &cfg, &stats) != 0) {
+            printf("Warning: batch with %d threads did not complete\n", t);
+        }
+        if (t == 1) base_qps = stats.queriesPerSecond;
+        double speedup = base_qps > 0 ? stats.queriesPerSecond / base_qps : 0.0;
+        printf("%8d %12.4f %14.2f %10.2f %11.1f%% %10lld\n", t, stats.seconds,
+               stats.queriesPerSecond, speedup, speedup / t * 100.0, stats.steals);
+    }
+}
+
 /**
  * 性能测试函数
  * @param graph 图指针
+ * @param sources 源点数组
  * @param num_queries 查询数量
+ * @param mode 堆的使用方式
  */
-void performance_test(Graph* graph, int num_queries) {
+void performance_test(Graph* graph, const int* sources, int num_queries, DijkstraMode mode) {
     if (!graph) return;
     
-    printf("Starting performance test (%d queries)...\n", num_queries);
+    printf("Starting performance test (%d queries, mode: %s)...\n", num_queries, MODE_NAMES[mode]);
     
-    int* dist = (int*)malloc(graph->num_nodes * sizeof(int));
+    QueryContext* ctx = create_query_context(graph);
     long long total_time = 0;
+    long long total_peak = 0;
+    long long total_stale = 0;
+    int max_peak = 0;
     int valid_queries = 0;
     
-    srand(time(NULL));  // 初始化随机种子
-    
     for (int i = 0; i < num_queries; i++) {
-        // 随机选择源节点
-        int source = rand() % graph->num_nodes;
+        int source = sources[i];
         
         long long start_time = get_time_us();
-        dijkstra_binary_heap(graph, source, dist);
+        dijkstra_binary_heap(source, ctx, mode);
         long long end_time = get_time_us();
         
         long long elapsed = end_time - start_time;
         total_time += elapsed;
+        total_peak += ctx->heap_peak;
+        total_stale += ctx->stale_pops;
+        if (ctx->heap_peak > max_peak) max_peak = ctx->heap_peak;
         valid_queries++;
         
         if ((i + 1) % 100 == 0) {
@@ -397,33 +635,146 @@ void performance_test(Graph* graph, int num_queries) {
         }
     }
     
-printf("\n=== Performance Test Results ===\n");
+    printf("\n=== Performance Test Results (%s) ===\n", MODE_NAMES[mode]);
     printf("Total queries: %d\n", valid_queries);
     printf("Total time: %.2f seconds\n", total_time / 1000000.0);
     printf("Average time per query: %.2f microseconds\n", (double)total_time / valid_queries);
-    printf("Average time per query: %.2f milliseconds\n", (double)total_time / valid_queries / 1000.0);   
-    free(dist);
+    printf("Average time per query: %.2f milliseconds\n", (double)total_time / valid_queries / 1000.0);
+    printf("Heap high-water mark: max %d, average %.1f entries (%d vertices)\n",
+           max_peak, (double)total_peak / valid_queries, graph->numVertices);
+    if (mode == MODE_DUPLICATE) {
+        printf("Stale entries skipped: %.1f per query\n", (double)total_stale / valid_queries);
+    }
+    free_query_context(ctx);
+}
+
+/**
+ * 随机点对测试：同一源点先做一对多查询，再做目标集合查询（终点全部确定即停止），
+ * 对比确定节点数和延迟，并逐个比对终点距离
+ * @param graph 图指针
+ * @param sources 源点数组
+ * @param num_queries 查询数量
+ * @param num_targets 每个源点的随机终点数（1 即随机点对）
+ * @param max_dist 距离上限，< 0 表示不限
+ * @param mode 堆的使用方式
+ */
+void pairs_test(Graph* graph, const int* sources, int num_queries, int num_targets, long long max_dist,
+                DijkstraMode mode) {
+    QueryContext* ctx = create_query_context(graph);
+    int* targets = (int*)malloc(num_targets * sizeof(int));
+    long long* expected = (long long*)malloc(num_targets * sizeof(long long));
+    long long* out = (long long*)malloc(num_targets * sizeof(long long));
+    long long full_time = 0, early_time = 0;
+    long long full_settled = 0, early_settled = 0;
+    long long mismatches = 0;
+    
+    for (int i = 0; i < num_queries; i++) {
+        for (int j = 0; j < num_targets; j++) {
+            targets[j] = rand() % graph->numVertices + 1;
+        }
+        
+        long long start_time = get_time_us();
+        dijkstra_binary_heap(sources[i], ctx, mode);
+        long long mid_time = get_time_us();
+        full_settled += ctx->settled;
+        for (int j = 0; j < num_targets; j++) {
+            long long d = query_get_dist(ctx, targets[j]);
+            expected[j] = (max_dist >= 0 && d > max_dist) ? DIJKSTRA_INF : d;
+        }
+        
+        long long early_start = get_time_us();
+        dijkstra_binary_heap_targets(sources[i], targets, num_targets, max_dist, ctx, mode, out);
+        long long end_time = get_time_us();
+        early_settled += ctx->settled;
+        full_time += mid_time - start_time;
+        early_time += end_time - early_start;
+        
+        for (int j = 0; j < num_targets; j++) {
+            if (out[j] != expected[j]) mismatches++;
+        }
+    }
+    
+    printf("\n=== Random Pair Results (%s, %d target(s) per source", MODE_NAMES[mode], num_targets);
+    if (max_dist >= 0) printf(", max distance %lld", max_dist);
+    printf(") ===\n");
+    printf("%12s %16s %18s\n", "", "Avg settled", "Avg time (us)");
+    printf("%12s %16.1f %18.2f\n", "One-to-all", (double)full_settled / num_queries,
+           (double)full_time / num_queries);
+    printf("%12s %16.1f %18.2f\n", "Early exit", (double)early_settled / num_queries,
+           (double)early_time / num_queries);
+    printf("Speedup: %.2f, mismatches: %lld\n",
+           early_time > 0 ? (double)full_time / early_time : 0.0, mismatches);
+    
+    free(targets);
+    free(expected);
+    free(out);
+    free_query_context(ctx);
 }
 
 // ==================== 主程序 ====================
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        printf("Usage: %s <graph_file> <query_count>\n", argv[0]);
-        printf("Example: %s USA-road-d.NY.gr 1000\n", argv[0]);
+    if (argc < 3) {
+        printf("Usage: %s <graph_file> <query_count> [threads] [--mode insert-all|lazy|duplicate|all]\n"
+               "       [--pairs [--targets k] [--max-dist d]]\n", argv[0]);
+        printf("Example: %s USA-road-d.NY.gr 1000 8 --mode lazy\n", argv[0]);
+        printf("Example: %s USA-road-d.NY.gr 1000 --pairs --targets 4 --mode lazy\n", argv[0]);
         return 1;
     }
     
     const char* filename = argv[1];
     int num_queries = atoi(argv[2]);
+    int num_threads = 1;
+    int mode = MODE_INSERT_ALL;
+    int all_modes = 0;
+    int pairs = 0;
+    int num_targets = 1;
+    long long max_dist = -1;
+    
+    // 可选参数：线程数（位置参数）与 --mode
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (strcmp(name, "all") == 0) {
+                all_modes = 1;
+                continue;
+            }
+            for (mode = 0; mode < MODE_COUNT; mode++) {
+                if (strcmp(name, MODE_NAMES[mode]) == 0) break;
+            }
+            if (mode == MODE_COUNT) {
+                printf("Unknown mode: %s\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--pairs") == 0) {
+            pairs = 1;
+        } else if (strcmp(argv[i], "--targets") == 0 && i + 1 < argc) {
+            num_targets = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-dist") == 0 && i + 1 < argc) {
+            max_dist = atoll(argv[++i]);
+        } else if (i == 3 && argv[i][0] != '-') {
+            num_threads = atoi(argv[i]);
+        } else {
+            printf("Unknown argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
     
     if (num_queries < 1) {
         printf("Query count must be greater than 0\n");
         return 1;
     }
+    if (num_threads < 1) {
+        printf("Thread count must be greater than 0\n");
+        return 1;
+    }
+    if (num_targets < 1) {
+        printf("Target count must be greater than 0\n");
+        return 1;
+    }
     
     printf("Reading graph file: %s\n", filename);
-    Graph* graph = read_txt_graph(filename);
+    Graph* graph = loadGraph(filename);
     
     if (!graph) {
         printf("Failed to read graph\n");
@@ -431,14 +782,32 @@ int main(int argc, char* argv[]) {
     }
     
     printf("Graph read successfully!\n");
-    printf("Number of nodes: %d\n", graph->num_nodes);
-    printf("Number of edges: %d\n", graph->num_edges);
+    printf("Number of nodes: %d\n", graph->numVertices);
+    printf("Number of edges: %d\n", graph->numEdges);
     
-    // 运行性能测试
-    performance_test(graph, num_queries);
+    // 随机源点（所有模式使用同一批，便于比较）
+    int* sources = (int*)malloc(num_queries * sizeof(int));
+    srand(time(NULL));  // 初始化随机种子
+    for (int i = 0; i < num_queries; i++) {
+        sources[i] = rand() % graph->numVertices + 1;
+    }
+    
+    // 运行性能测试（多线程时报告 1 到 num_threads 的扩展效率）
+    int first = all_modes ? 0 : mode;
+    int last = all_modes ? MODE_COUNT - 1 : mode;
+    for (int m = first; m <= last; m++) {
+        if (pairs) {
+            pairs_test(graph, sources, num_queries, num_targets, max_dist, (DijkstraMode)m);
+        } else if (num_threads > 1) {
+            parallel_performance_test(graph, sources, num_queries, num_threads, (DijkstraMode)m);
+        } else {
+            performance_test(graph, sources, num_queries, (DijkstraMode)m);
+        }
+    }
     
     // 清理内存
-    free_graph(graph);
+    free(sources);
+    graphDestroy(graph);
     
     return 0;
 
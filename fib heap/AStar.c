@@ -0,0 +1,179 @@
+#include "AStar.h"
+#include "DijkstraKernel.h"
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// 地球平均半径 (米)
+#define ASTAR_EARTH_RADIUS 6371008.8
+// 坐标单位: 10^-6 度 → 弧度
+#define ASTAR_MICRODEG_TO_RAD (M_PI / 180.0 / 1e6)
+// 标定系数的安全余量: 给每条边留出 1e-6 * w 的余量, 远大于浮点舍入误差,
+// 保证取整后的下界仍然一致 (基数堆要求键单调)
+#define ASTAR_SCALE_SAFETY (1.0 - 1e-6)
+
+// 内部函数: 两点之间的大圆距离 (米), 输入为弧度
+static inline double greatCircle(double lon1, double lat1, double cosLat1, double lon2, double lat2) {
+    double sdLat = sin((lat2 - lat1) * 0.5);
+    double sdLon = sin((lon2 - lon1) * 0.5);
+    double a = sdLat * sdLat + cosLat1 * cos(lat2) * sdLon * sdLon;
+    if (a > 1.0) a = 1.0;
+    return 2.0 * ASTAR_EARTH_RADIUS * asin(sqrt(a));
+}
+
+// 内部函数: 两个顶点之间的几何距离
+static double geoDistance(const GraphCoord* a, const GraphCoord* b, AStarMetric metric) {
+    if (metric == ASTAR_METRIC_GREAT_CIRCLE) {
+        double lat1 = a->y * ASTAR_MICRODEG_TO_RAD;
+        return greatCircle(a->x * ASTAR_MICRODEG_TO_RAD, lat1, cos(lat1),
+                           b->x * ASTAR_MICRODEG_TO_RAD, b->y * ASTAR_MICRODEG_TO_RAD);
+    }
+    double dx = (double)a->x - b->x;
+    double dy = (double)a->y - b->y;
+    return sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * @brief 度量的显示名称
+ */
+const char* astarMetricName(AStarMetric metric) {
+    switch (metric) {
+        case ASTAR_METRIC_EUCLIDEAN:    return "Euclidean";
+        case ASTAR_METRIC_GREAT_CIRCLE: return "Great-circle";
+        default:                        return "Auto";
+    }
+}
+
+/**
+ * @brief 标定几何下界的系数
+ */
+double astarCalibrateScale(const Graph* g, AStarMetric metric, AStarMetric* resolved) {
+    if (g->coords == NULL) {
+        fprintf(stderr, "错误: A* 需要顶点坐标 (.co 文件)。\n");
+        return -1.0;
+    }
+    const GraphCoord* c = g->coords;
+
+    if (metric == ASTAR_METRIC_AUTO) {
+        metric = ASTAR_METRIC_GREAT_CIRCLE;
+        for (int v = 1; v <= g->numVertices; ++v) {
+            if (c[v].x < -180000000 || c[v].x > 180000000 || c[v].y < -90000000 || c[v].y > 90000000) {
+                metric = ASTAR_METRIC_EUCLIDEAN;
+                break;
+            }
+        }
+    }
+    if (resolved != NULL) *resolved = metric;
+
+    // scale = min(weight / geo), 只考虑几何长度为正的边
+    double scale = -1.0;
+    for (int u = 1; u <= g->numVertices; ++u) {
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            double geo = geoDistance(&c[u], &c[g->targets[e]], metric);
+            if (geo <= 0.0) continue;
+            double ratio = g->weights[e] / geo;
+            if (scale < 0.0 || ratio < scale) scale = ratio;
+        }
+    }
+    return scale < 0.0 ? 0.0 : scale * ASTAR_SCALE_SAFETY;
+}
+
+/**
+ * @brief 创建 A* 查询上下文
+ */
+AStarContext* createAStarContext(const Graph* g, PriorityQueueKind kind, AStarMetric metric, double scale) {
+    if (g->coords == NULL) {
+        fprintf(stderr, "错误: A* 需要顶点坐标 (.co 文件)。\n");
+        return NULL;
+    }
+    AStarContext* ac = (AStarContext*)calloc(1, sizeof(AStarContext));
+    if (ac == NULL) {
+        perror("错误: 无法为A*上下文分配内存");
+        return NULL;
+    }
+    if (scale < 0.0 || metric == ASTAR_METRIC_AUTO) {
+        double calibrated = astarCalibrateScale(g, metric, &ac->metric);
+        if (scale < 0.0) scale = calibrated;
+    } else {
+        ac->metric = metric;
+    }
+    ac->scale = scale;
+    ac->base = createDijkstraContextWithQueue(g, kind);
+    ac->hcache = (long long*)malloc((g->numVertices + 1) * sizeof(long long));
+    if (ac->base == NULL || ac->hcache == NULL) {
+        perror("错误: 无法为A*上下文分配内存");
+        astarContextDestroy(ac);
+        return NULL;
+    }
+    return ac;
+}
+
+/**
+ * @brief 销毁 A* 查询上下文
+ */
+void astarContextDestroy(AStarContext* ac) {
+    if (ac == NULL) return;
+    dijkstraContextDestroy(ac->base);
+    free(ac->hcache);
+    free(ac);
+}
+
+// 内部函数: v 到当前终点的下界 (向下取整, 保持一致性且为整数键)
+static inline long long astarHeuristic(const AStarContext* ac, int v) {
+    const GraphCoord* c = &ac->base->g->coords[v];
+    double geo;
+    if (ac->metric == ASTAR_METRIC_GREAT_CIRCLE) {
+        geo = greatCircle(ac->targetX, ac->targetY, ac->targetCosLat,
+                          c->x * ASTAR_MICRODEG_TO_RAD, c->y * ASTAR_MICRODEG_TO_RAD);
+    } else {
+        double dx = c->x - ac->targetX;
+        double dy = c->y - ac->targetY;
+        geo = sqrt(dx * dx + dy * dy);
+    }
+    return (long long)floor(geo * ac->scale);
+}
+
+// --- 特化内核 (每种队列一个) ---
+
+#define ASTAR_DEFINE_QUEUE_KERNEL(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY,                          \
+                                  RESET, PUSH, DECREASE, POP, EMPTY, MINKEY)                       \
+    DIJKSTRA_DEFINE_ASTAR_KERNEL(astar##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY,        \
+                                 AStarContext, astarHeuristic)
+
+DIJKSTRA_QUEUE_LIST(ASTAR_DEFINE_QUEUE_KERNEL)
+
+#undef ASTAR_DEFINE_QUEUE_KERNEL
+
+/**
+ * @brief A* 点对点查询
+ */
+long long astarQuery(AStarContext* ac, int source, int target) {
+    DijkstraContext* ctx = ac->base;
+    int V = ctx->g->numVertices;
+    if (source <= 0 || source > V || target <= 0 || target > V) {
+        fprintf(stderr, "错误: 起点 %d 或终点 %d 无效。\n", source, target);
+        return -1;
+    }
+
+    const GraphCoord* t = &ctx->g->coords[target];
+    if (ac->metric == ASTAR_METRIC_GREAT_CIRCLE) {
+        ac->targetX = t->x * ASTAR_MICRODEG_TO_RAD;
+        ac->targetY = t->y * ASTAR_MICRODEG_TO_RAD;
+        ac->targetCosLat = cos(ac->targetY);
+    } else {
+        ac->targetX = t->x;
+        ac->targetY = t->y;
+    }
+
+    switch (ctx->kind) {
+#define ASTAR_CASE(KIND, SUFFIX, QUEUE_T, ...) \
+        case KIND: astar##SUFFIX(ctx, (QUEUE_T*)ctx->pq, ac, ac->hcache, source, target); break;
+        DIJKSTRA_QUEUE_LIST(ASTAR_CASE)
+#undef ASTAR_CASE
+        default: return -1;
+    }
+    return dijkstraGetDist(ctx, target);
+}
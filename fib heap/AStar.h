@@ -0,0 +1,73 @@
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include "Graph.h"
+#include "Dijkstra.h"
+
+/**
+ * @brief A* 使用的几何下界
+ */
+typedef enum AStarMetric {
+    ASTAR_METRIC_AUTO = 0,      // 坐标都在经纬度范围内 (|x| <= 180e6, |y| <= 90e6) 时用大圆距离, 否则欧氏距离
+    ASTAR_METRIC_EUCLIDEAN,     // 坐标平面上的欧氏距离
+    ASTAR_METRIC_GREAT_CIRCLE,  // 把坐标视为 经度 / 纬度 * 10^6 (DIMACS .co), 取球面大圆距离 (米)
+} AStarMetric;
+
+/**
+ * @brief A* 点对点查询上下文
+ *
+ * 下界 h(v) = scale * geo(v, target), geo 为几何距离。scale 在创建时标定为
+ * 所有边上 weight / geo(u, v) 的最小值 (再略微缩小以吸收浮点误差), 于是每条边都满足
+ * scale * geo(u, v) <= w(u, v); 由三角不等式, h 既可采纳又一致,
+ * 且与边权的单位无关 (无论权重是米、分米还是时间)。
+ */
+typedef struct AStarContext {
+    DijkstraContext* base;     // 距离 / 堆等查询状态 (复用普通 Dijkstra 上下文)
+    long long* hcache;         // 本次查询中各顶点的下界, 仅对已触及的顶点有效
+    AStarMetric metric;        // 实际使用的度量 (不会是 AUTO)
+    double scale;              // 几何距离 → 权重单位的系数
+    // --- 当前查询的终点 (预先算好, 每次求下界只剩一次距离计算) ---
+    double targetX, targetY;   // 欧氏: 原始坐标; 大圆: 经度 / 纬度 (弧度)
+    double targetCosLat;
+} AStarContext;
+
+/**
+ * @brief 标定几何下界的系数 (O(E))
+ * @param g 图 (必须已加载坐标)
+ * @param metric 度量, ASTAR_METRIC_AUTO 会按坐标范围选择
+ * @param resolved 输出实际使用的度量, 可为 NULL
+ * @return 系数 (>= 0), 没有坐标时返回 -1
+ */
+double astarCalibrateScale(const Graph* g, AStarMetric metric, AStarMetric* resolved);
+
+/**
+ * @brief 创建 A* 查询上下文
+ * @param g 图 (必须已加载坐标, 见 graphLoadCoordinates)
+ * @param kind 优先队列种类
+ * @param metric 度量
+ * @param scale 由 astarCalibrateScale 得到的系数 (多个上下文可共享一次标定), < 0 表示现在标定
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+AStarContext* createAStarContext(const Graph* g, PriorityQueueKind kind, AStarMetric metric, double scale);
+
+/**
+ * @brief 销毁 A* 查询上下文
+ */
+void astarContextDestroy(AStarContext* ac);
+
+/**
+ * @brief A* 点对点查询
+ * @param ac 上下文
+ * @param source 起点
+ * @param target 终点
+ * @return 最短距离 (不可达时为 DIJKSTRA_INF), 顶点无效时返回 -1;
+ *         ac->base->numSettled 为确定的顶点数
+ */
+long long astarQuery(AStarContext* ac, int source, int target);
+
+/**
+ * @brief 度量的显示名称
+ */
+const char* astarMetricName(AStarMetric metric);
+
+#endif // ASTAR_H
@@ -0,0 +1,196 @@
+#include "BatchQuery.h"
+#include "Graph.h" // graphNowSeconds
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+/**
+ * @brief 工作线程的任务队列
+ *
+ * 任务是源点数组中的下标区间 [top, bottom): 所有者从 bottom 端取,
+ * 窃取者从 top 端取。任务不会在执行期间新增, 所以窃取可以一次拿走一整段。
+ * 每个队列占满一个缓存行, 避免相邻队列之间的伪共享。
+ */
+typedef struct WorkDeque {
+    pthread_mutex_t lock;
+    int top;
+    int bottom;
+    char pad[64];
+} WorkDeque;
+
+typedef struct BatchEngine BatchEngine;
+
+typedef struct BatchWorker {
+    BatchEngine* engine;
+    int id;
+    int completed;
+    int failed;
+    long long steals;
+    unsigned int rng;   // 选择窃取对象的随机数状态
+} BatchWorker;
+
+struct BatchEngine {
+    const int* sources;
+    int numThreads;
+    const BatchWorkerOps* ops;
+    void* userData;
+    WorkDeque* deques;
+    BatchWorker* workers;
+};
+
+// 内部函数：从自己队列的底部取一个任务, 队列为空时返回 -1
+static int popBottom(WorkDeque* dq) {
+    int idx = -1;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->bottom > dq->top) {
+        idx = --dq->bottom;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return idx;
+}
+
+/**
+ * @brief 从其他线程窃取任务
+ *
+ * 从随机位置开始轮询所有其他队列, 从第一个非空队列的顶部拿走一半任务
+ * (至少一个) 放入自己的队列。所有队列都为空时返回 0, 此时批量任务已取完。
+ */
+static int stealWork(BatchWorker* self) {
+    BatchEngine* engine = self->engine;
+    int n = engine->numThreads;
+    self->rng = self->rng * 1103515245u + 12345u;
+    int start = (int)((self->rng >> 8) % (unsigned int)n);
+
+    for (int k = 0; k < n; ++k) {
+        int victimId = (start + k) % n;
+        if (victimId == self->id) continue;
+        WorkDeque* victim = &engine->deques[victimId];
+
+        pthread_mutex_lock(&victim->lock);
+        int available = victim->bottom - victim->top;
+        if (available <= 0) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        int take = (available + 1) / 2;
+        int begin = victim->top;
+        victim->top += take;
+        pthread_mutex_unlock(&victim->lock);
+
+        WorkDeque* own = &engine->deques[self->id];
+        pthread_mutex_lock(&own->lock);
+        own->top = begin;
+        own->bottom = begin + take;
+        pthread_mutex_unlock(&own->lock);
+        self->steals++;
+        return 1;
+    }
+    return 0;
+}
+
+// 工作线程主函数
+static void* workerMain(void* arg) {
+    BatchWorker* self = (BatchWorker*)arg;
+    BatchEngine* engine = self->engine;
+    const BatchWorkerOps* ops = engine->ops;
+
+    void* state = ops->createWorker(engine->userData);
+    if (state == NULL) {
+        self->failed = 1;
+        return NULL;
+    }
+
+    for (;;) {
+        int idx = popBottom(&engine->deques[self->id]);
+        if (idx < 0) {
+            if (!stealWork(self)) break;
+            continue;
+        }
+        ops->runQuery(state, engine->sources[idx], engine->userData);
+        self->completed++;
+    }
+
+    ops->destroyWorker(state);
+    return NULL;
+}
+
+/**
+ * @brief 批量执行查询
+ */
+int runBatchQueries(const int* sources, int numSources, int numThreads,
+                    const BatchWorkerOps* ops, void* userData, BatchStats* stats) {
+    if (numThreads <= 0) numThreads = 1;
+
+    BatchEngine engine;
+    engine.sources = sources;
+    engine.numThreads = numThreads;
+    engine.ops = ops;
+    engine.userData = userData;
+    engine.deques = (WorkDeque*)calloc(numThreads, sizeof(WorkDeque));
+    engine.workers = (BatchWorker*)calloc(numThreads, sizeof(BatchWorker));
+    pthread_t* tids = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    char* created = (char*)calloc(numThreads, 1);
+    if (engine.deques == NULL || engine.workers == NULL || tids == NULL || created == NULL) {
+        perror("错误: 无法为批量查询引擎分配内存");
+        free(engine.deques);
+        free(engine.workers);
+        free(tids);
+        free(created);
+        return -1;
+    }
+
+    // 初始分配: 每个线程一段连续的源点
+    for (int t = 0; t < numThreads; ++t) {
+        pthread_mutex_init(&engine.deques[t].lock, NULL);
+        engine.deques[t].top = (int)((long long)numSources * t / numThreads);
+        engine.deques[t].bottom = (int)((long long)numSources * (t + 1) / numThreads);
+        engine.workers[t].engine = &engine;
+        engine.workers[t].id = t;
+        engine.workers[t].rng = 2654435761u * (unsigned int)(t + 1);
+    }
+
+    double start = graphNowSeconds();
+    for (int t = 1; t < numThreads; ++t) {
+        created[t] = pthread_create(&tids[t], NULL, workerMain, &engine.workers[t]) == 0;
+    }
+    // 0号工作线程在调用线程上运行; 创建失败的线程的任务会被其他线程窃取
+    workerMain(&engine.workers[0]);
+    for (int t = 1; t < numThreads; ++t) {
+        if (created[t]) pthread_join(tids[t], NULL);
+    }
+    double elapsed = graphNowSeconds() - start;
+
+    int completed = 0;
+    int failed = 0;
+    long long steals = 0;
+    for (int t = 0; t < numThreads; ++t) {
+        completed += engine.workers[t].completed;
+        failed |= engine.workers[t].failed;
+        steals += engine.workers[t].steals;
+        pthread_mutex_destroy(&engine.deques[t].lock);
+    }
+
+    if (stats != NULL) {
+        stats->numThreads = numThreads;
+        stats->numQueries = completed;
+        stats->seconds = elapsed;
+        stats->queriesPerSecond = elapsed > 0 ? completed / elapsed : 0.0;
+        stats->steals = steals;
+    }
+
+    free(engine.deques);
+    free(engine.workers);
+    free(tids);
+    free(created);
+    return (failed || completed != numSources) ? -1 : 0;
+}
+
+/**
+ * @brief 扩展性测试的下一个线程数
+ */
+int batchNextThreadCount(int current, int maxThreads) {
+    if (current >= maxThreads) return 0;
+    int next = current * 2;
+    return next < maxThreads ? next : maxThreads;
+}
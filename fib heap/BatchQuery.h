@@ -0,0 +1,55 @@
+#ifndef BATCH_QUERY_H
+#define BATCH_QUERY_H
+
+/**
+ * @brief 批量查询引擎
+ *
+ * 把一组独立的一对多查询分配到线程池上执行。每个工作线程拥有一个双端队列:
+ * 自己从底部取任务, 空闲时从其他线程队列的顶部窃取一半任务 (work stealing)。
+ * 图是只读共享的; 堆和查询上下文等可写状态由每个工作线程通过回调各自创建。
+ */
+
+/**
+ * @brief 工作线程回调
+ *
+ * createWorker 在工作线程内调用, 返回该线程私有的状态 (例如查询上下文);
+ * runQuery 对一个源点执行一次查询; destroyWorker 在线程退出前释放状态。
+ */
+typedef struct BatchWorkerOps {
+    void* (*createWorker)(void* userData);
+    void (*runQuery)(void* worker, int source, void* userData);
+    void (*destroyWorker)(void* worker);
+} BatchWorkerOps;
+
+/**
+ * @brief 一次批量执行的统计
+ */
+typedef struct BatchStats {
+    int numThreads;           // 实际使用的线程数
+    int numQueries;           // 完成的查询数
+    double seconds;           // 墙钟耗时 (秒)
+    double queriesPerSecond;  // 总吞吐量
+    long long steals;         // 成功窃取的次数
+} BatchStats;
+
+/**
+ * @brief 在 numThreads 个线程上执行 sources 中的所有查询
+ *
+ * @param sources 源点数组
+ * @param numSources 源点个数
+ * @param numThreads 线程数 (<= 0 表示 1)
+ * @param ops 工作线程回调
+ * @param userData 传给回调的共享只读数据 (例如图)
+ * @param stats 输出统计, 可为 NULL
+ * @return 0 成功, -1 失败 (例如某个工作线程无法创建状态)
+ */
+int runBatchQueries(const int* sources, int numSources, int numThreads,
+                    const BatchWorkerOps* ops, void* userData, BatchStats* stats);
+
+/**
+ * @brief 扩展性测试的下一个线程数: 1, 2, 4, ... 直到 maxThreads (最后一项总是 maxThreads)
+ * @return 下一个线程数, 超过 maxThreads 时返回 0
+ */
+int batchNextThreadCount(int current, int maxThreads);
+
+#endif // BATCH_QUERY_H
@@ -0,0 +1,124 @@
+#include "BinaryHeap.h"
+
+/**
+ * @brief 创建二叉堆
+ */
+BinaryHeap* createBinaryHeap(int capacity) {
+    BinaryHeap* H = (BinaryHeap*)malloc(sizeof(BinaryHeap));
+    if (H == NULL) {
+        perror("错误: 无法为二叉堆分配内存");
+        return NULL;
+    }
+    H->heap = (BinaryHeapEntry*)malloc(capacity * sizeof(BinaryHeapEntry));
+    H->pos = (int*)malloc(capacity * sizeof(int));
+    H->size = 0;
+    H->capacity = capacity;
+    if (H->heap == NULL || H->pos == NULL) {
+        perror("错误: 无法为二叉堆数组分配内存");
+        binaryHeapDestroy(H);
+        return NULL;
+    }
+
+    // 初始化位置数组为-1 (表示不在堆中), 只在创建时做一次
+    for (int i = 0; i < capacity; i++) {
+        H->pos[i] = -1;
+    }
+    return H;
+}
+
+/**
+ * @brief 销毁堆
+ */
+void binaryHeapDestroy(BinaryHeap* H) {
+    if (H == NULL) return;
+    free(H->heap);
+    free(H->pos);
+    free(H);
+}
+
+/**
+ * @brief 清空堆
+ */
+void binaryHeapReset(BinaryHeap* H) {
+    for (int i = 0; i < H->size; i++) {
+        H->pos[H->heap[i].value] = -1;
+    }
+    H->size = 0;
+}
+
+/**
+ * @brief 上浮 (空穴法: 父节点下移, 最后一次写入)
+ */
+static void _binaryHeapSiftUp(BinaryHeap* H, int idx) {
+    BinaryHeapEntry item = H->heap[idx];
+    while (idx > 0) {
+        int parent = (idx - 1) / 2;
+        if (H->heap[parent].key <= item.key) break;
+        H->heap[idx] = H->heap[parent];
+        H->pos[H->heap[idx].value] = idx;
+        idx = parent;
+    }
+    H->heap[idx] = item;
+    H->pos[item.value] = idx;
+}
+
+/**
+ * @brief 下沉 (空穴法)
+ */
+static void _binaryHeapSiftDown(BinaryHeap* H, int idx) {
+    BinaryHeapEntry item = H->heap[idx];
+    int size = H->size;
+    for (;;) {
+        int child = 2 * idx + 1;
+        if (child >= size) break;
+        if (child + 1 < size && H->heap[child + 1].key < H->heap[child].key) {
+            child++;
+        }
+        if (item.key <= H->heap[child].key) break;
+        H->heap[idx] = H->heap[child];
+        H->pos[H->heap[idx].value] = idx;
+        idx = child;
+    }
+    H->heap[idx] = item;
+    H->pos[item.value] = idx;
+}
+
+/**
+ * @brief 插入顶点
+ */
+void binaryHeapInsert(BinaryHeap* H, long long key, int value) {
+    int idx = H->size++;
+    H->heap[idx].key = key;
+    H->heap[idx].value = value;
+    _binaryHeapSiftUp(H, idx);
+}
+
+/**
+ * @brief 提取最小键的顶点
+ */
+int binaryHeapExtractMin(BinaryHeap* H) {
+    if (H->size == 0) {
+        fprintf(stderr, "错误: 试图从空堆中提取。\n");
+        return -1;
+    }
+    int minValue = H->heap[0].value;
+    H->pos[minValue] = -1; // 标记为不在堆中
+
+    // 将最后一个元素移到根位置并下沉
+    H->size--;
+    if (H->size > 0) {
+        H->heap[0] = H->heap[H->size];
+        _binaryHeapSiftDown(H, 0);
+    }
+    return minValue;
+}
+
+/**
+ * @brief 减小键值
+ */
+void binaryHeapDecreaseKey(BinaryHeap* H, int value, long long newKey) {
+    int idx = H->pos[value];
+    if (idx < 0 || H->heap[idx].key <= newKey) return;
+    H->heap[idx].key = newKey;
+    _binaryHeapSiftUp(H, idx);
+}
@@ -0,0 +1,85 @@
+#ifndef BINARY_HEAP_H
+#define BINARY_HEAP_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h> // for LLONG_MAX
+
+/**
+ * @brief 二叉堆元素
+ * Key (键): long long (Dijkstra中的距离)
+ * Value (值): int (Dijkstra中的顶点ID)
+ */
+typedef struct BinaryHeapEntry {
+    long long key;
+    int value;
+} BinaryHeapEntry;
+
+/**
+ * @brief 带位置索引的二叉堆 (顶点ID即句柄)
+ *
+ * pos[v] 为顶点 v 在堆数组中的下标, 不在堆中时为 -1,
+ * 所以 decreaseKey 直接按顶点ID定位, 不需要额外的节点指针。
+ */
+typedef struct BinaryHeap {
+    BinaryHeapEntry* heap;  // 堆数组
+    int* pos;               // 顶点在堆中的位置, 长度 capacity
+    int size;               // 当前元素数
+    int capacity;           // 顶点ID上限 (不含)
+} BinaryHeap;
+
+/**
+ * @brief 创建二叉堆
+ * @param capacity 顶点ID上限 (Dijkstra中为 V+1)
+ * @return 指向新堆的指针, 失败则返回 NULL
+ */
+BinaryHeap* createBinaryHeap(int capacity);
+
+/**
+ * @brief 销毁堆
+ */
+void binaryHeapDestroy(BinaryHeap* H);
+
+/**
+ * @brief 清空堆 (只重置剩余元素的位置, O(size))
+ */
+void binaryHeapReset(BinaryHeap* H);
+
+/**
+ * @brief 插入顶点 (调用者保证 value 当前不在堆中)
+ */
+void binaryHeapInsert(BinaryHeap* H, long long key, int value);
+
+/**
+ * @brief 提取最小键的顶点
+ * @return 顶点ID, 堆为空时返回 -1
+ */
+int binaryHeapExtractMin(BinaryHeap* H);
+
+/**
+ * @brief 减小堆中顶点的键值 (顶点不在堆中时不做任何事)
+ */
+void binaryHeapDecreaseKey(BinaryHeap* H, int value, long long newKey);
+
+/**
+ * @brief 检查顶点是否在堆中
+ */
+static inline int binaryHeapContains(const BinaryHeap* H, int value) {
+    return H->pos[value] >= 0;
+}
+
+/**
+ * @brief 检查堆是否为空
+ */
+static inline int binaryHeapIsEmpty(const BinaryHeap* H) {
+    return H->size == 0;
+}
+
+/**
+ * @brief 查看最小键 (不提取), 堆为空时返回 LLONG_MAX
+ */
+static inline long long binaryHeapMinKey(const BinaryHeap* H) {
+    return H->size > 0 ? H->heap[0].key : LLONG_MAX;
+}
+
+#endif // BINARY_HEAP_H
@@ -0,0 +1,120 @@
+#define _DEFAULT_SOURCE // syscall
+
+#include "CacheProbe.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/**
+ * @brief 打开本线程的缓存缺失计数器
+ */
+int cacheCounterOpen(CacheCounter* c) {
+    c->fd = -1;
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd >= 0) {
+        c->fd = (int)fd;
+        return 0;
+    }
+#endif
+    return -1;
+}
+
+/**
+ * @brief 清零并开始计数
+ */
+void cacheCounterStart(CacheCounter* c) {
+#ifdef __linux__
+    if (c->fd < 0) return;
+    ioctl(c->fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(c->fd, PERF_EVENT_IOC_ENABLE, 0);
+#else
+    (void)c;
+#endif
+}
+
+/**
+ * @brief 停止计数并读取
+ */
+long long cacheCounterStop(CacheCounter* c) {
+#ifdef __linux__
+    if (c->fd < 0) return -1;
+    ioctl(c->fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(c->fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) return -1;
+    return count;
+#else
+    (void)c;
+    return -1;
+#endif
+}
+
+/**
+ * @brief 关闭计数器
+ */
+void cacheCounterClose(CacheCounter* c) {
+#ifdef __linux__
+    if (c->fd >= 0) close(c->fd);
+#endif
+    c->fd = -1;
+}
+
+/**
+ * @brief 创建缓存模型
+ */
+CacheModel* createCacheModel(size_t bytes, int ways) {
+    if (ways <= 0 || bytes < (size_t)ways * CACHE_LINE_BYTES) {
+        fprintf(stderr, "错误: 无效的缓存模型参数。\n");
+        return NULL;
+    }
+    CacheModel* m = (CacheModel*)malloc(sizeof(CacheModel));
+    if (m == NULL) {
+        perror("错误: 无法为缓存模型分配内存");
+        return NULL;
+    }
+    m->ways = ways;
+    m->numSets = (int)(bytes / CACHE_LINE_BYTES / ways);
+    m->tags = (unsigned long long*)calloc((size_t)m->numSets * ways, sizeof(unsigned long long));
+    if (m->tags == NULL) {
+        perror("错误: 无法为缓存模型分配内存");
+        free(m);
+        return NULL;
+    }
+    m->accesses = 0;
+    m->misses = 0;
+    return m;
+}
+
+/**
+ * @brief 清空缓存内容和统计
+ */
+void cacheModelReset(CacheModel* m) {
+    memset(m->tags, 0, (size_t)m->numSets * m->ways * sizeof(unsigned long long));
+    m->accesses = 0;
+    m->misses = 0;
+}
+
+/**
+ * @brief 销毁缓存模型
+ */
+void cacheModelDestroy(CacheModel* m) {
+    if (m == NULL) return;
+    free(m->tags);
+    free(m);
+}
@@ -0,0 +1,95 @@
+#ifndef CACHE_PROBE_H
+#define CACHE_PROBE_H
+
+#include <stddef.h>
+
+/**
+ * @brief 缓存缺失测量
+ *
+ * 1. 硬件计数器: 通过 perf_event_open 读取本线程的缓存缺失次数 (PERF_COUNT_HW_CACHE_MISSES,
+ *    通常是末级缓存)。虚拟机、容器或 perf_event_paranoid 限制下可能不可用。
+ * 2. 缓存模型: 组相联、LRU 替换、64 字节缓存行的软件模拟。调用者按访问顺序喂入地址,
+ *    结果与硬件无关, 可重复, 适合比较不同数据布局。
+ */
+#define CACHE_LINE_BYTES 64
+
+/**
+ * @brief 硬件缓存缺失计数器
+ */
+typedef struct CacheCounter {
+    int fd;                 // perf 事件描述符, < 0 表示不可用
+} CacheCounter;
+
+/**
+ * @brief 打开本线程的缓存缺失计数器
+ * @return 0 成功, -1 不可用 (c->fd 为 -1, 其余函数变为空操作)
+ */
+int cacheCounterOpen(CacheCounter* c);
+
+/**
+ * @brief 清零并开始计数
+ */
+void cacheCounterStart(CacheCounter* c);
+
+/**
+ * @brief 停止计数
+ * @return 自 cacheCounterStart 以来的缺失次数, 不可用时返回 -1
+ */
+long long cacheCounterStop(CacheCounter* c);
+
+/**
+ * @brief 关闭计数器
+ */
+void cacheCounterClose(CacheCounter* c);
+
+/**
+ * @brief 组相联 LRU 缓存模型
+ */
+typedef struct CacheModel {
+    int numSets;
+    int ways;
+    unsigned long long* tags;   // numSets * ways, 每组按最近使用在前排列, 0 表示空
+    long long accesses;
+    long long misses;
+} CacheModel;
+
+/**
+ * @brief 创建缓存模型
+ * @param bytes 容量 (字节)
+ * @param ways 相联度
+ * @return 模型, 失败则返回 NULL
+ */
+CacheModel* createCacheModel(size_t bytes, int ways);
+
+/**
+ * @brief 清空缓存内容和统计
+ */
+void cacheModelReset(CacheModel* m);
+
+/**
+ * @brief 销毁缓存模型
+ */
+void cacheModelDestroy(CacheModel* m);
+
+/**
+ * @brief 访问 addr 所在的缓存行
+ * @return 1 缺失, 0 命中
+ */
+static inline int cacheModelAccess(CacheModel* m, const void* addr) {
+    // 行号 + 1: 标签 0 留给空槽
+    unsigned long long line = (unsigned long long)(size_t)addr / CACHE_LINE_BYTES + 1;
+    unsigned long long* set = m->tags + (size_t)(line % (unsigned long long)m->numSets) * m->ways;
+    m->accesses++;
+    int i = 0;
+    while (i < m->ways && set[i] != line) i++;
+    int miss = (i == m->ways);
+    if (miss) {
+        i = m->ways - 1;    // 淘汰最久未使用的
+        m->misses++;
+    }
+    for (; i > 0; --i) set[i] = set[i - 1];
+    set[0] = line;
+    return miss;
+}
+
+#endif // CACHE_PROBE_H
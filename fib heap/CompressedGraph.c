@@ -0,0 +1,187 @@
+#include "CompressedGraph.h"
+#include "DijkstraKernel.h"
+
+// 内部函数：LEB128 编码, 返回写入的字节数 (out 为 NULL 时只计算长度)
+static int writeVarint(unsigned char* out, unsigned int value) {
+    int n = 0;
+    while (value >= 0x80) {
+        if (out != NULL) out[n] = (unsigned char)(value | 0x80);
+        n++;
+        value >>= 7;
+    }
+    if (out != NULL) out[n] = (unsigned char)value;
+    return n + 1;
+}
+
+// 内部函数：把顶点 u 的出边按目标升序排入 scratch (插入排序: 道路图的出度很小)
+static int sortedEdges(const Graph* g, int u, int* targets, int* weights) {
+    int count = 0;
+    for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+        int t = g->targets[e];
+        int w = g->weights[e];
+        int i = count++;
+        while (i > 0 && targets[i - 1] > t) {
+            targets[i] = targets[i - 1];
+            weights[i] = weights[i - 1];
+            i--;
+        }
+        targets[i] = t;
+        weights[i] = w;
+    }
+    return count;
+}
+
+// 内部函数：编码顶点 u 的出边, 返回字节数 (out 为 NULL 时只计算长度)
+static size_t encodeVertex(unsigned char* out, int u, const int* targets, const int* weights, int count,
+                           int weightBytes) {
+    size_t n = 0;
+    int prev = u;
+    for (int i = 0; i < count; ++i) {
+        unsigned int delta;
+        if (i == 0) {
+            int d = targets[0] - u;
+            delta = ((unsigned int)d << 1) ^ (unsigned int)(d >> 31); // zigzag
+        } else {
+            delta = (unsigned int)(targets[i] - prev);
+        }
+        prev = targets[i];
+        n += writeVarint(out != NULL ? out + n : NULL, delta);
+        for (int b = 0; b < weightBytes; ++b) {
+            if (out != NULL) out[n] = (unsigned char)((unsigned int)weights[i] >> (8 * b));
+            n++;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief 由 CSR 图构建压缩存储 (两遍: 先算每个顶点的字节数, 再编码)
+ */
+CompressedGraph* compressGraph(const Graph* g) {
+    int V = g->numVertices;
+    int maxWeight = 0;
+    int maxDegree = 0;
+    for (int u = 1; u <= V; ++u) {
+        int degree = g->offsets[u + 1] - g->offsets[u];
+        if (degree > maxDegree) maxDegree = degree;
+    }
+    for (int e = 0; e < g->numEdges; ++e) {
+        if (g->weights[e] < 0) {
+            fprintf(stderr, "错误: 压缩存储要求边权非负。\n");
+            return NULL;
+        }
+        if (g->weights[e] > maxWeight) maxWeight = g->weights[e];
+    }
+
+    CompressedGraph* cg = (CompressedGraph*)calloc(1, sizeof(CompressedGraph));
+    int* targets = (int*)malloc((maxDegree > 0 ? maxDegree : 1) * sizeof(int));
+    int* weights = (int*)malloc((maxDegree > 0 ? maxDegree : 1) * sizeof(int));
+    if (cg == NULL || targets == NULL || weights == NULL) {
+        perror("错误: 无法为压缩图分配内存");
+        free(cg);
+        free(targets);
+        free(weights);
+        return NULL;
+    }
+    cg->numVertices = V;
+    cg->numEdges = g->numEdges;
+    cg->weightBytes = maxWeight < (1 << 8) ? 1 : maxWeight < (1 << 16) ? 2 : maxWeight < (1 << 24) ? 3 : 4;
+    cg->weightMask = cg->weightBytes == 4 ? 0xFFFFFFFFu : (1u << (8 * cg->weightBytes)) - 1;
+    cg->shape.numVertices = V;
+    cg->shape.numEdges = g->numEdges;
+    cg->offsets = (unsigned int*)malloc((V + 2) * sizeof(unsigned int));
+    if (cg->offsets == NULL) {
+        perror("错误: 无法为压缩图分配内存");
+        goto fail;
+    }
+
+    // 第一遍: 各顶点的字节数
+    size_t total = 0;
+    cg->offsets[0] = 0;
+    cg->offsets[1] = 0;
+    for (int u = 1; u <= V; ++u) {
+        int count = sortedEdges(g, u, targets, weights);
+        total += encodeVertex(NULL, u, targets, weights, count, cg->weightBytes);
+        if (total > 0xFFFFFFFFu) {
+            fprintf(stderr, "错误: 压缩后的边超过 4 GB, 无法用 32 位偏移表示。\n");
+            goto fail;
+        }
+        cg->offsets[u + 1] = (unsigned int)total;
+    }
+
+    // 第二遍: 编码
+    cg->dataSize = total;
+    cg->data = (unsigned char*)calloc(total + COMPRESSED_GRAPH_PADDING, 1);
+    if (cg->data == NULL) {
+        perror("错误: 无法为压缩图分配内存");
+        goto fail;
+    }
+    for (int u = 1; u <= V; ++u) {
+        int count = sortedEdges(g, u, targets, weights);
+        encodeVertex(cg->data + cg->offsets[u], u, targets, weights, count, cg->weightBytes);
+    }
+    free(targets);
+    free(weights);
+    return cg;
+
+fail:
+    free(targets);
+    free(weights);
+    compressedGraphDestroy(cg);
+    return NULL;
+}
+
+/**
+ * @brief 销毁压缩图
+ */
+void compressedGraphDestroy(CompressedGraph* cg) {
+    if (cg == NULL) return;
+    free(cg->offsets);
+    free(cg->data);
+    free(cg);
+}
+
+/**
+ * @brief 压缩存储占用的总字节数
+ */
+size_t compressedGraphBytes(const CompressedGraph* cg) {
+    return (size_t)(cg->numVertices + 2) * sizeof(unsigned int) + cg->dataSize + COMPRESSED_GRAPH_PADDING;
+}
+
+// --- 特化内核 (每种队列一个) ---
+
+#define COMPRESSED_DEFINE_QUEUE_KERNEL(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY,                     \
+                                       RESET, PUSH, DECREASE, POP, EMPTY, MINKEY)                  \
+    DIJKSTRA_DEFINE_COMPRESSED_KERNEL(compressed##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY)
+
+DIJKSTRA_QUEUE_LIST(COMPRESSED_DEFINE_QUEUE_KERNEL)
+
+#undef COMPRESSED_DEFINE_QUEUE_KERNEL
+
+/**
+ * @brief 创建可用于压缩图的查询上下文
+ */
+DijkstraContext* createCompressedDijkstraContext(const CompressedGraph* cg, PriorityQueueKind kind) {
+    return createDijkstraContextWithQueue(&cg->shape, kind);
+}
+
+/**
+ * @brief 在压缩图上的一对多 Dijkstra
+ */
+int compressedDijkstraRun(DijkstraContext* ctx, const CompressedGraph* cg, int source) {
+    if (ctx->g != &cg->shape) {
+        fprintf(stderr, "错误: 查询上下文不属于该压缩图。\n");
+        return -1;
+    }
+    if (source <= 0 || source > cg->numVertices) {
+        fprintf(stderr, "错误: 起始节点 %d 无效。\n", source);
+        return -1;
+    }
+    switch (ctx->kind) {
+#define COMPRESSED_CASE(KIND, SUFFIX, QUEUE_T, ...) \
+        case KIND: return compressed##SUFFIX(ctx, cg, (QUEUE_T*)ctx->pq, source);
+        DIJKSTRA_QUEUE_LIST(COMPRESSED_CASE)
+#undef COMPRESSED_CASE
+        default: return -1;
+    }
+}
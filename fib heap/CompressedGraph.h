@@ -0,0 +1,137 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <string.h>
+
+#include "Graph.h"
+#include "Dijkstra.h"
+
+/**
+ * @brief 压缩邻接存储
+ *
+ * 每个顶点的出边按目标ID升序排列后编码为一段字节流:
+ *   第一条边: zigzag(target - u) 的 varint, 之后每条边: (target - 上一个target) 的 varint;
+ *   每个目标后紧跟固定宽度的权重 (1..4 字节, 取所有权重都能放下的最小宽度, 小端)。
+ * varint 为按字节对齐的 LEB128 (每字节 7 位, 最高位表示还有后续字节)。
+ * offsets[u] 为顶点 u 的字节流起点, offsets[u+1] 为终点, 不单独存出度。
+ * 流的末尾多留 4 个字节, 解码权重时可以一次读 4 字节再按宽度取掩码。
+ *
+ * 顶点ID的局部性越好, 差值越小: 先用 VertexOrder 重新编号, 大多数目标只需 1 个字节。
+ */
+#define COMPRESSED_GRAPH_PADDING 4
+
+typedef struct CompressedGraph {
+    int numVertices;
+    int numEdges;
+    unsigned int* offsets;       // 长度 numVertices + 2, 字节偏移
+    unsigned char* data;         // 边的字节流 (末尾 COMPRESSED_GRAPH_PADDING 字节为 0)
+    size_t dataSize;             // 字节流长度 (不含填充)
+    int weightBytes;             // 权重宽度 (1..4)
+    unsigned int weightMask;     // 低 weightBytes 字节为 1 的掩码
+    Graph shape;                 // 只有顶点数 / 边数的图头 (不含邻接数组), 供 DijkstraContext 使用
+} CompressedGraph;
+
+/**
+ * @brief 由 CSR 图构建压缩存储
+ * @param g 图 (权重必须非负)
+ * @return 压缩图, 失败则返回 NULL
+ */
+CompressedGraph* compressGraph(const Graph* g);
+
+/**
+ * @brief 销毁压缩图
+ */
+void compressedGraphDestroy(CompressedGraph* cg);
+
+/**
+ * @brief 压缩存储占用的总字节数 (offsets + 字节流)
+ */
+size_t compressedGraphBytes(const CompressedGraph* cg);
+
+/**
+ * @brief 创建可用于压缩图的查询上下文
+ * @param cg 压缩图, 生命周期须长于上下文
+ * @param kind 优先队列种类
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+DijkstraContext* createCompressedDijkstraContext(const CompressedGraph* cg, PriorityQueueKind kind);
+
+/**
+ * @brief 在压缩图上的一对多 Dijkstra (与 dijkstraRun 相同, 结果用 dijkstraGetDist 读取)
+ * @return 确定的顶点数, 起点无效或上下文不属于该压缩图时返回 -1
+ */
+int compressedDijkstraRun(DijkstraContext* ctx, const CompressedGraph* cg, int source);
+
+/**
+ * @brief 出边解码迭代器
+ *
+ *     CompressedEdgeIter it;
+ *     compressedEdgesBegin(cg, u, &it);
+ *     int v, w;
+ *     while (compressedEdgesNext(&it, &v, &w)) { ... }
+ */
+typedef struct CompressedEdgeIter {
+    const unsigned char* p;
+    const unsigned char* end;
+    int target;                  // 上一个目标 (首条边之前为 u)
+    int first;                   // 是否尚未解码第一条边
+    int weightBytes;
+    unsigned int weightMask;
+} CompressedEdgeIter;
+
+// 内部函数：解码一个 LEB128 varint (大多数只有 1 个字节)
+static inline unsigned int compressedReadVarint(const unsigned char** p) {
+    const unsigned char* q = *p;
+    unsigned int value = *q++;
+    if (value >= 0x80) {
+        value &= 0x7F;
+        int shift = 7;
+        unsigned int b;
+        do {
+            b = *q++;
+            value |= (b & 0x7F) << shift;
+            shift += 7;
+        } while (b >= 0x80);
+    }
+    *p = q;
+    return value;
+}
+
+static inline void compressedEdgesBegin(const CompressedGraph* cg, int u, CompressedEdgeIter* it) {
+    it->p = cg->data + cg->offsets[u];
+    it->end = cg->data + cg->offsets[u + 1];
+    it->target = u;
+    it->first = 1;
+    it->weightBytes = cg->weightBytes;
+    it->weightMask = cg->weightMask;
+}
+
+/**
+ * @brief 解码下一条边
+ * @return 1 得到一条边, 0 没有更多的边
+ */
+static inline int compressedEdgesNext(CompressedEdgeIter* it, int* target, int* weight) {
+    if (it->p >= it->end) return 0;
+    unsigned int delta = compressedReadVarint(&it->p);
+    if (it->first) {
+        // zigzag: 第一条边相对 u 的差值可正可负
+        it->target += (int)(delta >> 1) ^ -(int)(delta & 1);
+        it->first = 0;
+    } else {
+        it->target += (int)delta;
+    }
+    unsigned int w;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(&w, it->p, sizeof(w)); // 末尾有填充, 多读的字节由掩码去掉
+    w &= it->weightMask;
+#else
+    w = 0;
+    for (int i = it->weightBytes - 1; i >= 0; --i) w = (w << 8) | it->p[i];
+#endif
+    it->p += it->weightBytes;
+    *target = it->target;
+    *weight = (int)w;
+    return 1;
+}
+
+#endif // COMPRESSED_GRAPH_H
@@ -0,0 +1,741 @@
+#define _POSIX_C_SOURCE 200809L // mmap
+
+#include "ContractionHierarchy.h"
+#include "DijkstraKernel.h"
+#include "BatchQuery.h"
+
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// --- 预处理使用的动态邻接表 ---
+
+typedef struct ChArc {
+    int to;
+    int weight;
+} ChArc;
+
+typedef struct ChArcList {
+    ChArc* arcs;
+    int count;
+    int capacity;
+} ChArcList;
+
+typedef struct ChShortcut {
+    int from;
+    int to;
+    long long weight;
+} ChShortcut;
+
+struct ChBuilder;
+
+/**
+ * @brief 见证搜索工作区 (每个工作线程一个, 跨轮次复用)
+ */
+typedef struct ChWorkspace {
+    struct ChBuilder* owner;
+    long long* dist;
+    unsigned int* stamp;       // stamp == epoch 时 dist 属于本次见证搜索
+    unsigned int epoch;
+    unsigned int* targetStamp; // targetStamp == epoch 时该顶点是本次搜索尚未确定的目标
+    BinaryHeap* heap;
+    ChShortcut* shortcuts;     // 本轮收缩产生的捷径, 由主线程统一插入
+    int numShortcuts;
+    int capacity;
+    int inUse;
+    int failed;
+} ChWorkspace;
+
+typedef enum ChPhase {
+    CH_PHASE_PRIORITY = 0,     // 模拟收缩, 计算优先级
+    CH_PHASE_CONTRACT,         // 收缩, 记录捷径
+} ChPhase;
+
+typedef struct ChBuilder {
+    int V;
+    ChArcList* out;            // 未收缩顶点之间的出边; 顶点收缩后冻结, 即为它的向上边
+    ChArcList* in;             // 入边; 顶点收缩后冻结, 即为它的向下边
+    int* rank;                 // 收缩顺序, -1 表示尚未收缩
+    int* priority;
+    int* deleted;              // 已收缩的邻居数
+    int* level;                // 层深: 已收缩邻居的最大层深 + 1
+    unsigned char* inRound;    // 本轮待收缩 (见证搜索绕开)
+    ChPhase phase;
+    ChWorkspace* pool;
+    int poolSize;
+    pthread_mutex_t poolLock;
+} ChBuilder;
+
+// 内部函数：追加一条边
+static int arcListPush(ChArcList* list, int to, int weight) {
+    if (list->count == list->capacity) {
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 4;
+        ChArc* arcs = (ChArc*)realloc(list->arcs, capacity * sizeof(ChArc));
+        if (arcs == NULL) return -1;
+        list->arcs = arcs;
+        list->capacity = capacity;
+    }
+    list->arcs[list->count].to = to;
+    list->arcs[list->count].weight = weight;
+    list->count++;
+    return 0;
+}
+
+// 内部函数：查找指向 to 的边
+static ChArc* arcListFind(ChArcList* list, int to) {
+    for (int i = 0; i < list->count; ++i) {
+        if (list->arcs[i].to == to) return &list->arcs[i];
+    }
+    return NULL;
+}
+
+// 内部函数：删除指向已收缩顶点的边
+static void arcListCompact(ChArcList* list, const int* rank) {
+    int kept = 0;
+    for (int i = 0; i < list->count; ++i) {
+        if (rank[list->arcs[i].to] < 0) list->arcs[kept++] = list->arcs[i];
+    }
+    list->count = kept;
+}
+
+// 内部函数：插入或缩短 u→x
+static int addArc(ChBuilder* b, int u, int x, int weight) {
+    ChArc* arc = arcListFind(&b->out[u], x);
+    if (arc != NULL) {
+        if (weight < arc->weight) {
+            arc->weight = weight;
+            arcListFind(&b->in[x], u)->weight = weight;
+        }
+        return 0;
+    }
+    if (arcListPush(&b->out[u], x, weight) != 0 || arcListPush(&b->in[x], u, weight) != 0) return -1;
+    return 0;
+}
+
+/**
+ * @brief 见证搜索: 从 source 出发的受限 Dijkstra
+ *
+ * 绕开 skip 和本轮所有待收缩的顶点; 所有目标 (调用前已标记 numTargets 个) 都确定、堆顶超过 limit
+ * 或确定顶点数达到 CH_WITNESS_SETTLE_LIMIT 时停止。未确定顶点的暂定距离也是真实路径长度, 可以作为见证。
+ */
+static void witnessSearch(const ChBuilder* b, ChWorkspace* ws, int source, int skip, long long limit,
+                          int numTargets) {
+    const unsigned int epoch = ws->epoch;
+    BinaryHeap* heap = ws->heap;
+    binaryHeapReset(heap);
+    ws->stamp[source] = epoch;
+    ws->dist[source] = 0;
+    binaryHeapInsert(heap, 0, source);
+
+    int settled = 0;
+    while (!binaryHeapIsEmpty(heap) && settled < CH_WITNESS_SETTLE_LIMIT && numTargets > 0) {
+        if (binaryHeapMinKey(heap) > limit) break;
+        int x = binaryHeapExtractMin(heap);
+        settled++;
+        if (ws->targetStamp[x] == epoch) numTargets--;
+        long long dx = ws->dist[x];
+        const ChArcList* list = &b->out[x];
+        for (int i = 0; i < list->count; ++i) {
+            int y = list->arcs[i].to;
+            if (y == skip || b->inRound[y]) continue;
+            long long nd = dx + list->arcs[i].weight;
+            if (ws->stamp[y] != epoch) {
+                ws->stamp[y] = epoch;
+                ws->dist[y] = nd;
+                binaryHeapInsert(heap, nd, y);
+            } else if (nd < ws->dist[y]) {
+                ws->dist[y] = nd;
+                binaryHeapDecreaseKey(heap, y, nd);
+            }
+        }
+    }
+}
+
+/**
+ * @brief (模拟) 收缩 v: 对每个入邻居 u 做一次见证搜索, 覆盖所有出邻居 x
+ * @param record 非0: 把捷径追加到 ws->shortcuts
+ * @return 需要的捷径数
+ */
+static int contractVertex(const ChBuilder* b, ChWorkspace* ws, int v, int record) {
+    const ChArcList* in = &b->in[v];
+    const ChArcList* out = &b->out[v];
+    long long maxOut = 0;
+    for (int j = 0; j < out->count; ++j) {
+        if (out->arcs[j].weight > maxOut) maxOut = out->arcs[j].weight;
+    }
+
+    int count = 0;
+    for (int i = 0; i < in->count; ++i) {
+        int u = in->arcs[i].to;
+        long long wu = in->arcs[i].weight;
+        if (++ws->epoch == 0) {
+            memset(ws->stamp, 0, (b->V + 1) * sizeof(unsigned int));
+            memset(ws->targetStamp, 0, (b->V + 1) * sizeof(unsigned int));
+            ws->epoch = 1;
+        }
+        int numTargets = 0;
+        for (int j = 0; j < out->count; ++j) {
+            int x = out->arcs[j].to;
+            if (x != u) {
+                ws->targetStamp[x] = ws->epoch;
+                numTargets++;
+            }
+        }
+        witnessSearch(b, ws, u, v, wu + maxOut, numTargets);
+        for (int j = 0; j < out->count; ++j) {
+            int x = out->arcs[j].to;
+            if (x == u) continue;
+            long long via = wu + out->arcs[j].weight;
+            if (ws->stamp[x] == ws->epoch && ws->dist[x] <= via) continue; // 有见证路径
+            count++;
+            if (!record) continue;
+            if (ws->numShortcuts == ws->capacity) {
+                int capacity = ws->capacity > 0 ? ws->capacity * 2 : 64;
+                ChShortcut* grown = (ChShortcut*)realloc(ws->shortcuts, capacity * sizeof(ChShortcut));
+                if (grown == NULL) {
+                    ws->failed = 1;
+                    continue;
+                }
+                ws->shortcuts = grown;
+                ws->capacity = capacity;
+            }
+            ChShortcut* sc = &ws->shortcuts[ws->numShortcuts++];
+            sc->from = u;
+            sc->to = x;
+            sc->weight = via;
+        }
+    }
+    return count;
+}
+
+// 内部函数：优先级 = 2 * 边差 + 已收缩的邻居数 + 层深
+static int computePriority(const ChBuilder* b, ChWorkspace* ws, int v) {
+    int shortcuts = contractVertex(b, ws, v, 0);
+    int edgeDifference = shortcuts - b->in[v].count - b->out[v].count;
+    return 2 * edgeDifference + b->deleted[v] + b->level[v];
+}
+
+// 内部函数：a 是否排在 c 之前收缩 (优先级相同时按打散的ID, 避免按编号成片收缩)
+static int chBefore(const ChBuilder* b, int a, int c) {
+    if (b->priority[a] != b->priority[c]) return b->priority[a] < b->priority[c];
+    unsigned int ha = (unsigned int)a * 2654435761u;
+    unsigned int hc = (unsigned int)c * 2654435761u;
+    if (ha != hc) return ha < hc;
+    return a < c;
+}
+
+// 内部函数：v 的优先级是否低于所有未收缩邻居 (这样选出的顶点互不相邻)
+static int isLocalMinimum(const ChBuilder* b, int v) {
+    const ChArcList* lists[2] = { &b->out[v], &b->in[v] };
+    for (int l = 0; l < 2; ++l) {
+        for (int i = 0; i < lists[l]->count; ++i) {
+            if (!chBefore(b, v, lists[l]->arcs[i].to)) return 0;
+        }
+    }
+    return 1;
+}
+
+// --- 批量查询回调: 工作区从池中借用, 线程退出时归还 ---
+
+static void* chCreateWorker(void* userData) {
+    ChBuilder* b = (ChBuilder*)userData;
+    ChWorkspace* ws = NULL;
+    pthread_mutex_lock(&b->poolLock);
+    for (int i = 0; i < b->poolSize; ++i) {
+        if (!b->pool[i].inUse) {
+            ws = &b->pool[i];
+            ws->inUse = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&b->poolLock);
+    return ws;
+}
+
+static void chRunVertex(void* worker, int v, void* userData) {
+    ChBuilder* b = (ChBuilder*)userData;
+    ChWorkspace* ws = (ChWorkspace*)worker;
+    if (b->phase == CH_PHASE_PRIORITY) {
+        b->priority[v] = computePriority(b, ws, v);
+    } else {
+        contractVertex(b, ws, v, 1);
+    }
+}
+
+static void chDestroyWorker(void* worker) {
+    ChWorkspace* ws = (ChWorkspace*)worker;
+    pthread_mutex_lock(&ws->owner->poolLock);
+    ws->inUse = 0;
+    pthread_mutex_unlock(&ws->owner->poolLock);
+}
+
+// 内部函数：释放构建器
+static void chBuilderFree(ChBuilder* b) {
+    for (int v = 0; b->out != NULL && v <= b->V; ++v) free(b->out[v].arcs);
+    for (int v = 0; b->in != NULL && v <= b->V; ++v) free(b->in[v].arcs);
+    free(b->out);
+    free(b->in);
+    free(b->priority);
+    free(b->deleted);
+    free(b->level);
+    free(b->inRound);
+    for (int i = 0; b->pool != NULL && i < b->poolSize; ++i) {
+        free(b->pool[i].dist);
+        free(b->pool[i].stamp);
+        free(b->pool[i].targetStamp);
+        binaryHeapDestroy(b->pool[i].heap);
+        free(b->pool[i].shortcuts);
+    }
+    free(b->pool);
+    pthread_mutex_destroy(&b->poolLock);
+}
+
+// 内部函数：由冻结的邻接表生成向上 / 向下 CSR
+static Graph* buildSearchGraph(const ChBuilder* b, const ChArcList* lists) {
+    int m = 0;
+    for (int v = 1; v <= b->V; ++v) m += lists[v].count;
+    int* src = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    int* dst = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    int* weight = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    Graph* g = NULL;
+    if (src != NULL && dst != NULL && weight != NULL) {
+        int i = 0;
+        for (int v = 1; v <= b->V; ++v) {
+            for (int j = 0; j < lists[v].count; ++j) {
+                src[i] = v;
+                dst[i] = lists[v].arcs[j].to;
+                weight[i] = lists[v].arcs[j].weight;
+                i++;
+            }
+        }
+        g = createGraphFromEdges(b->V, m, src, dst, weight);
+    } else {
+        perror("错误: 无法为收缩层次分配内存");
+    }
+    free(src);
+    free(dst);
+    free(weight);
+    return g;
+}
+
+/**
+ * @brief 构建收缩层次
+ */
+ContractionHierarchy* chBuild(const Graph* g, int numThreads, ChBuildStats* stats) {
+    double start = graphNowSeconds();
+    if (numThreads <= 0) numThreads = 1;
+    int V = g->numVertices;
+
+    ChBuilder b;
+    memset(&b, 0, sizeof(b));
+    b.V = V;
+    pthread_mutex_init(&b.poolLock, NULL);
+    b.out = (ChArcList*)calloc(V + 1, sizeof(ChArcList));
+    b.in = (ChArcList*)calloc(V + 1, sizeof(ChArcList));
+    b.rank = (int*)malloc((V + 1) * sizeof(int));
+    b.priority = (int*)calloc(V + 1, sizeof(int));
+    b.deleted = (int*)calloc(V + 1, sizeof(int));
+    b.level = (int*)calloc(V + 1, sizeof(int));
+    b.inRound = (unsigned char*)calloc(V + 1, 1);
+    b.pool = (ChWorkspace*)calloc(numThreads, sizeof(ChWorkspace));
+    int* remaining = (int*)malloc((V > 0 ? V : 1) * sizeof(int));
+    int* set = (int*)malloc((V > 0 ? V : 1) * sizeof(int));
+    int* dirty = (int*)malloc((V > 0 ? V : 1) * sizeof(int));
+    int* mark = (int*)calloc(V + 1, sizeof(int)); // 去重: 平行边 / 本轮已记入的邻居
+    int* markPos = (int*)malloc((V + 1) * sizeof(int));
+    ContractionHierarchy* ch = (ContractionHierarchy*)calloc(1, sizeof(ContractionHierarchy));
+    int failed = (b.out == NULL || b.in == NULL || b.rank == NULL || b.priority == NULL || b.deleted == NULL ||
+                  b.level == NULL || b.inRound == NULL || b.pool == NULL || remaining == NULL || set == NULL ||
+                  dirty == NULL || mark == NULL || markPos == NULL || ch == NULL);
+    if (!failed) {
+        b.poolSize = numThreads;
+        for (int i = 0; i < numThreads && !failed; ++i) {
+            ChWorkspace* ws = &b.pool[i];
+            ws->owner = &b;
+            ws->dist = (long long*)malloc((V + 1) * sizeof(long long));
+            ws->stamp = (unsigned int*)calloc(V + 1, sizeof(unsigned int));
+            ws->targetStamp = (unsigned int*)calloc(V + 1, sizeof(unsigned int));
+            ws->heap = createBinaryHeap(V + 1);
+            failed = (ws->dist == NULL || ws->stamp == NULL || ws->targetStamp == NULL || ws->heap == NULL);
+        }
+    }
+
+    // --- 1. 初始化动态邻接表 (去掉自环, 平行边只保留最短的) ---
+    for (int u = 1; u <= V && !failed; ++u) {
+        b.rank[u] = -1;
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            int v = g->targets[e];
+            int w = g->weights[e];
+            if (v == u) continue;
+            if (mark[v] == u) {
+                ChArc* arc = &b.out[u].arcs[markPos[v]];
+                if (w < arc->weight) {
+                    arc->weight = w;
+                    arcListFind(&b.in[v], u)->weight = w;
+                }
+                continue;
+            }
+            mark[v] = u;
+            markPos[v] = b.out[u].count;
+            if (arcListPush(&b.out[u], v, w) != 0 || arcListPush(&b.in[v], u, w) != 0) {
+                failed = 1;
+                break;
+            }
+        }
+    }
+    if (failed) {
+        perror("错误: 无法为收缩层次分配内存");
+        goto fail;
+    }
+    b.rank[0] = -1;
+    memset(mark, 0, (V + 1) * sizeof(int));
+
+    BatchWorkerOps ops = {chCreateWorker, chRunVertex, chDestroyWorker};
+    int numRemaining = V;
+    for (int v = 1; v <= V; ++v) remaining[v - 1] = v;
+
+    // --- 2. 初始优先级 (并行模拟收缩) ---
+    b.phase = CH_PHASE_PRIORITY;
+    if (runBatchQueries(remaining, numRemaining, numThreads, &ops, &b, NULL) != 0) goto fail;
+
+    int rounds = 0;
+    long long shortcuts = 0;
+    int nextRank = 0;
+    while (numRemaining > 0) {
+        rounds++;
+
+        // --- 3. 独立集: 优先级低于所有未收缩邻居的顶点 ---
+        int setSize = 0;
+        for (int i = 0; i < numRemaining; ++i) {
+            int v = remaining[i];
+            if (isLocalMinimum(&b, v)) set[setSize++] = v;
+        }
+        for (int i = 0; i < setSize; ++i) b.inRound[set[i]] = 1;
+
+        // --- 4. 并行见证搜索, 再顺序插入捷径 ---
+        b.phase = CH_PHASE_CONTRACT;
+        if (runBatchQueries(set, setSize, numThreads, &ops, &b, NULL) != 0) goto fail;
+        for (int t = 0; t < b.poolSize; ++t) {
+            ChWorkspace* ws = &b.pool[t];
+            if (ws->failed) {
+                fprintf(stderr, "错误: 无法为捷径分配内存。\n");
+                goto fail;
+            }
+            for (int i = 0; i < ws->numShortcuts; ++i) {
+                const ChShortcut* sc = &ws->shortcuts[i];
+                if (sc->weight > INT_MAX) {
+                    fprintf(stderr, "错误: 捷径长度 %lld 超出 int 范围。\n", sc->weight);
+                    goto fail;
+                }
+                if (addArc(&b, sc->from, sc->to, (int)sc->weight) != 0) {
+                    perror("错误: 无法为捷径分配内存");
+                    goto fail;
+                }
+            }
+            shortcuts += ws->numShortcuts;
+            ws->numShortcuts = 0;
+        }
+
+        // --- 5. 标记收缩, 更新邻居的层深 / 已收缩邻居数, 删除指向已收缩顶点的边 ---
+        for (int i = 0; i < setSize; ++i) {
+            b.rank[set[i]] = nextRank++;
+            b.inRound[set[i]] = 0;
+        }
+        int numDirty = 0;
+        for (int i = 0; i < setSize; ++i) {
+            int v = set[i];
+            const ChArcList* lists[2] = { &b.out[v], &b.in[v] };
+            for (int l = 0; l < 2; ++l) {
+                for (int j = 0; j < lists[l]->count; ++j) {
+                    int x = lists[l]->arcs[j].to;
+                    if (markPos[x] == v && mark[x] == rounds) continue; // 同一邻居只计一次
+                    markPos[x] = v;
+                    b.deleted[x]++;
+                    if (b.level[v] + 1 > b.level[x]) b.level[x] = b.level[v] + 1;
+                    if (mark[x] != rounds) {
+                        mark[x] = rounds;
+                        dirty[numDirty++] = x;
+                    }
+                }
+            }
+        }
+        for (int i = 0; i < numDirty; ++i) {
+            arcListCompact(&b.out[dirty[i]], b.rank);
+            arcListCompact(&b.in[dirty[i]], b.rank);
+        }
+
+        int kept = 0;
+        for (int i = 0; i < numRemaining; ++i) {
+            if (b.rank[remaining[i]] < 0) remaining[kept++] = remaining[i];
+        }
+        numRemaining = kept;
+
+        // --- 6. 只重新计算受影响邻居的优先级 ---
+        b.phase = CH_PHASE_PRIORITY;
+        if (runBatchQueries(dirty, numDirty, numThreads, &ops, &b, NULL) != 0) goto fail;
+    }
+
+    // --- 7. 冻结的邻接表即为向上 / 向下边 ---
+    ch->numVertices = V;
+    ch->numEdges = g->numEdges;
+    ch->upward = buildSearchGraph(&b, b.out);
+    ch->downward = buildSearchGraph(&b, b.in);
+    if (ch->upward == NULL || ch->downward == NULL) goto fail;
+    ch->rank = b.rank;
+    b.rank = NULL;
+
+    if (stats != NULL) {
+        stats->seconds = graphNowSeconds() - start;
+        stats->rounds = rounds;
+        stats->shortcuts = shortcuts;
+        stats->numThreads = numThreads;
+    }
+    chBuilderFree(&b);
+    free(remaining);
+    free(set);
+    free(dirty);
+    free(mark);
+    free(markPos);
+    return ch;
+
+fail:
+    chDestroy(ch);
+    free(b.rank);
+    chBuilderFree(&b);
+    free(remaining);
+    free(set);
+    free(dirty);
+    free(mark);
+    free(markPos);
+    return NULL;
+}
+
+// 内部函数：按文件布局计算各段偏移
+static void chLayout(ChFileHeader* header) {
+    unsigned long long offsetsBytes = (unsigned long long)(header->numVertices + 2) * sizeof(int);
+    unsigned long long upBytes = (unsigned long long)header->numUpArcs * sizeof(int);
+    unsigned long long downBytes = (unsigned long long)header->numDownArcs * sizeof(int);
+    header->rankPos = graphFileAlignUp(sizeof(ChFileHeader));
+    header->upOffsetsPos = graphFileAlignUp(header->rankPos + (unsigned long long)(header->numVertices + 1) * sizeof(int));
+    header->upTargetsPos = graphFileAlignUp(header->upOffsetsPos + offsetsBytes);
+    header->upWeightsPos = graphFileAlignUp(header->upTargetsPos + upBytes);
+    header->downOffsetsPos = graphFileAlignUp(header->upWeightsPos + upBytes);
+    header->downTargetsPos = graphFileAlignUp(header->downOffsetsPos + offsetsBytes);
+    header->downWeightsPos = graphFileAlignUp(header->downTargetsPos + downBytes);
+    header->fileSize = graphFileAlignUp(header->downWeightsPos + downBytes);
+}
+
+/**
+ * @brief 收缩层次文件大小
+ */
+unsigned long long chFileSize(const ContractionHierarchy* ch) {
+    ChFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.numVertices = ch->numVertices;
+    header.numUpArcs = ch->upward->numEdges;
+    header.numDownArcs = ch->downward->numEdges;
+    chLayout(&header);
+    return header.fileSize;
+}
+
+/**
+ * @brief 写入收缩层次文件
+ */
+int chSave(const ContractionHierarchy* ch, const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) {
+        perror("错误: 无法创建收缩层次文件");
+        return -1;
+    }
+
+    ChFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CH_FILE_MAGIC, sizeof(header.magic));
+    header.version = CH_FILE_VERSION;
+    header.headerSize = sizeof(ChFileHeader);
+    header.numVertices = ch->numVertices;
+    header.numEdges = ch->numEdges;
+    header.numUpArcs = ch->upward->numEdges;
+    header.numDownArcs = ch->downward->numEdges;
+    chLayout(&header);
+
+    size_t offsetsBytes = (size_t)(ch->numVertices + 2) * sizeof(int);
+    size_t upBytes = (size_t)header.numUpArcs * sizeof(int);
+    size_t downBytes = (size_t)header.numDownArcs * sizeof(int);
+    unsigned long long pos = 0;
+    int status = graphWriteSection(file, &header, sizeof(header), &pos);
+    if (status == 0) status = graphWriteSection(file, ch->rank, (size_t)(ch->numVertices + 1) * sizeof(int), &pos);
+    if (status == 0) status = graphWriteSection(file, ch->upward->offsets, offsetsBytes, &pos);
+    if (status == 0) status = graphWriteSection(file, ch->upward->targets, upBytes, &pos);
+    if (status == 0) status = graphWriteSection(file, ch->upward->weights, upBytes, &pos);
+    if (status == 0) status = graphWriteSection(file, ch->downward->offsets, offsetsBytes, &pos);
+    if (status == 0) status = graphWriteSection(file, ch->downward->targets, downBytes, &pos);
+    if (status == 0) status = graphWriteSection(file, ch->downward->weights, downBytes, &pos);
+
+    if (fclose(file) != 0) status = -1;
+    if (status != 0) {
+        perror("错误: 写入收缩层次文件失败");
+        return -1;
+    }
+    return 0;
+}
+
+// 内部函数：指向映射区的搜索图 (mapping 为 NULL: 映射由收缩层次统一解除)
+static Graph* mappedGraph(const char* bytes, int V, int m, unsigned long long offsetsPos,
+                          unsigned long long targetsPos, unsigned long long weightsPos) {
+    Graph* g = (Graph*)calloc(1, sizeof(Graph));
+    if (g == NULL) return NULL;
+    g->numVertices = V;
+    g->numEdges = m;
+    g->offsets = (int*)(bytes + offsetsPos);
+    g->targets = (int*)(bytes + targetsPos);
+    g->weights = (int*)(bytes + weightsPos);
+    return g;
+}
+
+/**
+ * @brief mmap 加载收缩层次
+ */
+ContractionHierarchy* chLoad(const char* filename, const Graph* g) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("错误: 无法打开收缩层次文件");
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ChFileHeader)) {
+        fprintf(stderr, "错误: 收缩层次文件 %s 过小或无法读取。\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror("错误: 无法映射收缩层次文件");
+        return NULL;
+    }
+
+    const ChFileHeader* header = (const ChFileHeader*)base;
+    ChFileHeader expected = *header;
+    if (header->numVertices >= 0 && header->numUpArcs >= 0 && header->numDownArcs >= 0) chLayout(&expected);
+    if (memcmp(header->magic, CH_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != CH_FILE_VERSION ||
+        header->headerSize != sizeof(ChFileHeader) ||
+        header->numVertices < 0 || header->numUpArcs < 0 || header->numDownArcs < 0 ||
+        memcmp(&expected, header, sizeof(ChFileHeader)) != 0 ||
+        header->fileSize > size) {
+        fprintf(stderr, "错误: %s 不是有效的收缩层次文件 (版本 %d)。\n", filename, CH_FILE_VERSION);
+        munmap(base, size);
+        return NULL;
+    }
+    if (g != NULL && (header->numVertices != g->numVertices || header->numEdges != g->numEdges)) {
+        fprintf(stderr, "错误: 收缩层次文件 %s 对应的图 (%d 个顶点, %d 条边) 与当前图不一致。\n",
+                filename, header->numVertices, header->numEdges);
+        munmap(base, size);
+        return NULL;
+    }
+
+    const char* bytes = (const char*)base;
+    ContractionHierarchy* ch = (ContractionHierarchy*)calloc(1, sizeof(ContractionHierarchy));
+    if (ch != NULL) {
+        ch->mapping = base;
+        ch->mappingSize = size;
+        ch->numVertices = header->numVertices;
+        ch->numEdges = header->numEdges;
+        ch->rank = (const int*)(bytes + header->rankPos);
+        ch->upward = mappedGraph(bytes, header->numVertices, header->numUpArcs, header->upOffsetsPos,
+                                 header->upTargetsPos, header->upWeightsPos);
+        ch->downward = mappedGraph(bytes, header->numVertices, header->numDownArcs, header->downOffsetsPos,
+                                   header->downTargetsPos, header->downWeightsPos);
+    }
+    if (ch == NULL || ch->upward == NULL || ch->downward == NULL) {
+        perror("错误: 无法为收缩层次分配内存");
+        if (ch == NULL) munmap(base, size);
+        chDestroy(ch);
+        return NULL;
+    }
+    return ch;
+}
+
+/**
+ * @brief 销毁收缩层次
+ */
+void chDestroy(ContractionHierarchy* ch) {
+    if (ch == NULL) return;
+    if (ch->mapping != NULL) {
+        // 搜索图的数组位于映射区内, 只释放结构体
+        free(ch->upward);
+        free(ch->downward);
+        munmap(ch->mapping, ch->mappingSize);
+    } else {
+        graphDestroy(ch->upward);
+        graphDestroy(ch->downward);
+        free((void*)ch->rank);
+    }
+    free(ch);
+}
+
+// --- 特化查询内核 (每种队列一个) ---
+
+#define CH_DEFINE_QUEUE_KERNEL(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY,                             \
+                               RESET, PUSH, DECREASE, POP, EMPTY, MINKEY)                          \
+    DIJKSTRA_DEFINE_CH_KERNEL(ch##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY, MINKEY,      \
+                              ChQueryContext)
+
+DIJKSTRA_QUEUE_LIST(CH_DEFINE_QUEUE_KERNEL)
+
+#undef CH_DEFINE_QUEUE_KERNEL
+
+/**
+ * @brief 创建收缩层次查询上下文
+ */
+ChQueryContext* createChQueryContext(const ContractionHierarchy* ch, PriorityQueueKind kind) {
+    ChQueryContext* qc = (ChQueryContext*)calloc(1, sizeof(ChQueryContext));
+    if (qc == NULL) {
+        perror("错误: 无法为收缩层次查询上下文分配内存");
+        return NULL;
+    }
+    qc->stallOnDemand = 1;
+    qc->forward = createDijkstraContextWithQueue(ch->upward, kind);
+    qc->backward = createDijkstraContextWithQueue(ch->downward, kind);
+    if (qc->forward == NULL || qc->backward == NULL) {
+        chQueryContextDestroy(qc);
+        return NULL;
+    }
+    return qc;
+}
+
+/**
+ * @brief 销毁收缩层次查询上下文
+ */
+void chQueryContextDestroy(ChQueryContext* qc) {
+    if (qc == NULL) return;
+    dijkstraContextDestroy(qc->forward);
+    dijkstraContextDestroy(qc->backward);
+    free(qc);
+}
+
+/**
+ * @brief 收缩层次点对点查询
+ */
+long long chQuery(ChQueryContext* qc, int source, int target) {
+    int V = qc->forward->g->numVertices;
+    if (source <= 0 || source > V || target <= 0 || target > V) {
+        fprintf(stderr, "错误: 起点 %d 或终点 %d 无效。\n", source, target);
+        return -1;
+    }
+    switch (qc->forward->kind) {
+#define CH_CASE(KIND, SUFFIX, ...) \
+        case KIND: return ch##SUFFIX(qc, source, target);
+        DIJKSTRA_QUEUE_LIST(CH_CASE)
+#undef CH_CASE
+        default: return -1;
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "Graph.h"
+#include "Dijkstra.h"
+
+/**
+ * @brief 收缩层次 (Contraction Hierarchies)
+ *
+ * 预处理按优先级逐个"收缩"顶点: 删除顶点 v, 对每对邻居 u→v→x, 若不存在不经过 v 且不更长的
+ * 见证路径 (witness), 就添加捷径 u→x。收缩顺序即顶点的层次 (rank)。
+ * 查询只需在两个 CSR 图上做双向搜索, 每个方向只沿层次升高的边前进:
+ *   upward:   顶点 v 的出边 v→x (rank[x] > rank[v]), 前向搜索使用
+ *   downward: 顶点 v 的入边 u→v (rank[u] > rank[v]), 存为 v→u, 后向搜索使用
+ * 两个方向的搜索空间都只有几百个顶点。
+ *
+ * 文件布局 (本机字节序, 各段按64字节对齐):
+ *   [ChFileHeader][rank: int * (V+1)][upward offsets/targets/weights][downward offsets/targets/weights]
+ * 加载时整个文件被 mmap 为只读, 两个 Graph 直接指向映射区。
+ */
+#define CH_FILE_MAGIC   "ADSCHIER"
+#define CH_FILE_VERSION 1
+
+// 见证搜索每次最多确定的顶点数 (超出时视为没有见证路径, 只会多加捷径, 不影响正确性)
+#define CH_WITNESS_SETTLE_LIMIT 500
+
+typedef struct ChFileHeader {
+    char magic[8];                    // CH_FILE_MAGIC
+    unsigned int version;             // CH_FILE_VERSION
+    unsigned int headerSize;          // sizeof(ChFileHeader)
+    int numVertices;                  // 原图的顶点数 / 边数 (加载时用于校验是否为同一张图)
+    int numEdges;
+    int numUpArcs;
+    int numDownArcs;
+    unsigned long long rankPos;       // 各段在文件中的字节偏移
+    unsigned long long upOffsetsPos;
+    unsigned long long upTargetsPos;
+    unsigned long long upWeightsPos;
+    unsigned long long downOffsetsPos;
+    unsigned long long downTargetsPos;
+    unsigned long long downWeightsPos;
+    unsigned long long fileSize;
+} ChFileHeader;
+
+/**
+ * @brief 收缩层次
+ */
+typedef struct ContractionHierarchy {
+    int numVertices;
+    int numEdges;           // 原图边数
+    const int* rank;        // 收缩顺序 (0 最先收缩), 长度 V+1
+    Graph* upward;          // 前向搜索图
+    Graph* downward;        // 后向搜索图
+    void* mapping;          // 若非NULL: 上述数组直接指向只读映射的文件 (零拷贝)
+    size_t mappingSize;     // 映射长度 (字节)
+} ContractionHierarchy;
+
+/**
+ * @brief 预处理统计
+ */
+typedef struct ChBuildStats {
+    double seconds;         // 总耗时
+    int rounds;             // 独立集轮数
+    long long shortcuts;    // 添加的捷径数 (合并前)
+    int numThreads;         // 使用的线程数
+} ChBuildStats;
+
+/**
+ * @brief 构建收缩层次
+ *
+ * 优先级 = 2 * 边差 (捷径数 - 删除的边数) + 已收缩的邻居数 + 层深。
+ * 每一轮选出优先级严格低于所有未收缩邻居的顶点 (互不相邻的独立集),
+ * 并行做见证搜索算出各自的捷径, 再顺序插入捷径; 只重新计算受影响邻居的优先级。
+ * 同一轮的见证搜索会绕开本轮所有待收缩的顶点, 因此各顶点的捷径互不依赖。
+ *
+ * @param g 图
+ * @param numThreads 线程数
+ * @param stats 输出统计, 可为 NULL
+ * @return 收缩层次, 失败则返回 NULL
+ */
+ContractionHierarchy* chBuild(const Graph* g, int numThreads, ChBuildStats* stats);
+
+/**
+ * @brief 写入收缩层次文件
+ * @return 0 成功, -1 失败
+ */
+int chSave(const ContractionHierarchy* ch, const char* filename);
+
+/**
+ * @brief 以只读 mmap 方式加载收缩层次 (零拷贝)
+ * @param filename 文件名
+ * @param g 对应的原图 (校验顶点数 / 边数), 可为 NULL
+ * @return 收缩层次, 失败则返回 NULL
+ */
+ContractionHierarchy* chLoad(const char* filename, const Graph* g);
+
+/**
+ * @brief 销毁收缩层次
+ */
+void chDestroy(ContractionHierarchy* ch);
+
+/**
+ * @brief 收缩层次文件大小 (字节)
+ */
+unsigned long long chFileSize(const ContractionHierarchy* ch);
+
+/**
+ * @brief 收缩层次查询上下文
+ */
+typedef struct ChQueryContext {
+    DijkstraContext* forward;    // 在 upward 上从起点搜索
+    DijkstraContext* backward;   // 在 downward 上从终点搜索
+    int stallOnDemand;           // 非0: 若顶点可经由更高层的已访问顶点更短地到达, 则不展开它
+    int meetVertex;              // 最短路径上层次最高的顶点 (不可达时为 0)
+    int numSettled;              // 两个方向共确定的顶点数
+} ChQueryContext;
+
+/**
+ * @brief 创建收缩层次查询上下文 (默认开启 stall-on-demand)
+ * @param ch 收缩层次, 生命周期须长于上下文
+ * @param kind 优先队列种类
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+ChQueryContext* createChQueryContext(const ContractionHierarchy* ch, PriorityQueueKind kind);
+
+/**
+ * @brief 销毁收缩层次查询上下文
+ */
+void chQueryContextDestroy(ChQueryContext* qc);
+
+/**
+ * @brief 点对点查询: 双向向上搜索, 每个方向在堆顶 >= 当前最优 μ 时停止
+ * @return 最短距离 (不可达时为 DIJKSTRA_INF), 顶点无效时返回 -1
+ */
+long long chQuery(ChQueryContext* qc, int source, int target);
+
+#endif // CONTRACTION_HIERARCHY_H
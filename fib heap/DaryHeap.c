@@ -0,0 +1,190 @@
+#include "DaryHeap.h"
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+#define D DARY_HEAP_D
+// 逻辑下标 → 物理槽
+#define SLOT(i) ((i) + D - 1)
+
+// 内部函数: 物理槽数 (向上取整到整条缓存行, 并为最后一组孩子留出余量)
+static size_t _daryHeapSlots(int capacity) {
+    size_t slots = (size_t)capacity + 2 * D;
+    return (slots + 7) & ~(size_t)7;
+}
+
+/**
+ * @brief 创建 d 叉堆
+ */
+DaryHeap* createDaryHeap(int capacity) {
+    DaryHeap* H = (DaryHeap*)malloc(sizeof(DaryHeap));
+    if (H == NULL) {
+        perror("错误: 无法为d叉堆分配内存");
+        return NULL;
+    }
+    size_t slots = _daryHeapSlots(capacity);
+    H->keys = (long long*)aligned_alloc(64, slots * sizeof(long long));
+    H->values = (int*)malloc(slots * sizeof(int));
+    H->pos = (int*)malloc(capacity * sizeof(int));
+    H->size = 0;
+    H->capacity = capacity;
+    if (H->keys == NULL || H->values == NULL || H->pos == NULL) {
+        perror("错误: 无法为d叉堆数组分配内存");
+        daryHeapDestroy(H);
+        return NULL;
+    }
+
+    // 空槽的键为 LLONG_MAX, 位置为 -1, 只在创建时做一次
+    for (size_t s = 0; s < slots; s++) {
+        H->keys[s] = LLONG_MAX;
+    }
+    for (int i = 0; i < capacity; i++) {
+        H->pos[i] = -1;
+    }
+    return H;
+}
+
+/**
+ * @brief 销毁堆
+ */
+void daryHeapDestroy(DaryHeap* H) {
+    if (H == NULL) return;
+    free(H->keys);
+    free(H->values);
+    free(H->pos);
+    free(H);
+}
+
+/**
+ * @brief 清空堆
+ */
+void daryHeapReset(DaryHeap* H) {
+    for (int i = 0; i < H->size; i++) {
+        H->pos[H->values[SLOT(i)]] = -1;
+        H->keys[SLOT(i)] = LLONG_MAX;
+    }
+    H->size = 0;
+}
+
+// 内部函数: 一组 d 个键 (对齐) 中最小者的组内下标
+static inline int _daryHeapMinChild(const long long* group) {
+#if defined(__AVX2__)
+    __m256i v = _mm256_load_si256((const __m256i*)group);
+#if D == 8
+    __m256i w = _mm256_load_si256((const __m256i*)(group + 4));
+    __m256i m = _mm256_blendv_epi8(v, w, _mm256_cmpgt_epi64(v, w));
+#else
+    __m256i m = v;
+#endif
+    // 两次折半, 把最小值广播到所有 lane
+    __m256i s = _mm256_permute4x64_epi64(m, _MM_SHUFFLE(1, 0, 3, 2));
+    m = _mm256_blendv_epi8(m, s, _mm256_cmpgt_epi64(m, s));
+    s = _mm256_permute4x64_epi64(m, _MM_SHUFFLE(2, 3, 0, 1));
+    m = _mm256_blendv_epi8(m, s, _mm256_cmpgt_epi64(m, s));
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, m)));
+#if D == 8
+    mask |= _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(w, m))) << 4;
+#endif
+    return __builtin_ctz(mask);
+#elif defined(__SSE4_2__)
+    __m128i v[D / 2];
+    __m128i m = v[0] = _mm_load_si128((const __m128i*)group);
+    for (int k = 1; k < D / 2; k++) {
+        v[k] = _mm_load_si128((const __m128i*)(group + 2 * k));
+        m = _mm_blendv_epi8(m, v[k], _mm_cmpgt_epi64(m, v[k]));
+    }
+    __m128i s = _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2));
+    m = _mm_blendv_epi8(m, s, _mm_cmpgt_epi64(m, s));
+    int mask = 0;
+    for (int k = 0; k < D / 2; k++) {
+        mask |= _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(v[k], m))) << (2 * k);
+    }
+    return __builtin_ctz(mask);
+#else
+    int best = 0;
+    for (int k = 1; k < D; k++) {
+        if (group[k] < group[best]) best = k;
+    }
+    return best;
+#endif
+}
+
+/**
+ * @brief 上浮 (空穴法: 父节点下移, 最后一次写入)
+ */
+static void _daryHeapSiftUp(DaryHeap* H, int idx, long long key, int value) {
+    long long* keys = H->keys;
+    int* values = H->values;
+    while (idx > 0) {
+        int parent = (idx - 1) / D;
+        if (keys[SLOT(parent)] <= key) break;
+        keys[SLOT(idx)] = keys[SLOT(parent)];
+        values[SLOT(idx)] = values[SLOT(parent)];
+        H->pos[values[SLOT(idx)]] = idx;
+        idx = parent;
+    }
+    keys[SLOT(idx)] = key;
+    values[SLOT(idx)] = value;
+    H->pos[value] = idx;
+}
+
+/**
+ * @brief 下沉 (空穴法, 每层整组选最小孩子)
+ */
+static void _daryHeapSiftDown(DaryHeap* H, int idx, long long key, int value) {
+    long long* keys = H->keys;
+    int* values = H->values;
+    int size = H->size;
+    for (;;) {
+        int first = D * idx + 1;
+        if (first >= size) break;
+        int child = first + _daryHeapMinChild(&keys[SLOT(first)]);
+        if (key <= keys[SLOT(child)]) break;
+        keys[SLOT(idx)] = keys[SLOT(child)];
+        values[SLOT(idx)] = values[SLOT(child)];
+        H->pos[values[SLOT(idx)]] = idx;
+        idx = child;
+    }
+    keys[SLOT(idx)] = key;
+    values[SLOT(idx)] = value;
+    H->pos[value] = idx;
+}
+
+/**
+ * @brief 插入顶点
+ */
+void daryHeapInsert(DaryHeap* H, long long key, int value) {
+    _daryHeapSiftUp(H, H->size++, key, value);
+}
+
+/**
+ * @brief 提取最小键的顶点
+ */
+int daryHeapExtractMin(DaryHeap* H) {
+    if (H->size == 0) {
+        fprintf(stderr, "错误: 试图从空堆中提取。\n");
+        return -1;
+    }
+    int minValue = H->values[SLOT(0)];
+    H->pos[minValue] = -1; // 标记为不在堆中
+
+    // 取出最后一个元素, 其槽位恢复为 LLONG_MAX, 再从根开始下沉
+    int last = --H->size;
+    long long key = H->keys[SLOT(last)];
+    int value = H->values[SLOT(last)];
+    H->keys[SLOT(last)] = LLONG_MAX;
+    if (last > 0) {
+        _daryHeapSiftDown(H, 0, key, value);
+    }
+    return minValue;
+}
+
+/**
+ * @brief 减小键值
+ */
+void daryHeapDecreaseKey(DaryHeap* H, int value, long long newKey) {
+    int idx = H->pos[value];
+    if (idx < 0 || H->keys[SLOT(idx)] <= newKey) return;
+    _daryHeapSiftUp(H, idx, newKey, value);
+}
@@ -0,0 +1,93 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h> // for LLONG_MAX
+
+// 分支因子, 编译时选择: -DDARY_HEAP_D=4 (默认) 或 -DDARY_HEAP_D=8
+#ifndef DARY_HEAP_D
+#define DARY_HEAP_D 4
+#endif
+
+#if DARY_HEAP_D != 4 && DARY_HEAP_D != 8
+#error "DARY_HEAP_D 只支持 4 或 8"
+#endif
+
+/**
+ * @brief 缓存对齐的 d 叉隐式堆 (顶点ID即句柄)
+ *
+ * 逻辑下标 i 存放在物理槽 i + d - 1, 于是 i 的 d 个孩子位于
+ * [d*(i+1), d*(i+1) + d): 每组孩子的键正好占 d*8 字节, 且按 d*8 字节对齐
+ * (d=8 时恰为一条 64 字节缓存行, d=4 时两组共享一行)。
+ * 键与顶点ID分两个数组存放, 选最小孩子时只读键数组, 支持 AVX2 / SSE4.2 时
+ * 用 64 位 SIMD 比较一次处理整组; 超出 size 的槽保持为 LLONG_MAX, 所以不完整的
+ * 最后一组也可以整组比较。上浮 / 下沉都用空穴法, 每层只写一次。
+ *
+ * 键必须小于 LLONG_MAX。
+ */
+typedef struct DaryHeap {
+    long long* keys;   // 物理槽的键 (64 字节对齐)
+    int* values;       // 物理槽的顶点ID
+    int* pos;          // 顶点的逻辑下标, 不在堆中时为 -1, 长度 capacity
+    int size;          // 当前元素数
+    int capacity;      // 顶点ID上限 (不含)
+} DaryHeap;
+
+/**
+ * @brief 创建 d 叉堆
+ * @param capacity 顶点ID上限 (Dijkstra中为 V+1)
+ * @return 指向新堆的指针, 失败则返回 NULL
+ */
+DaryHeap* createDaryHeap(int capacity);
+
+/**
+ * @brief 销毁堆
+ */
+void daryHeapDestroy(DaryHeap* H);
+
+/**
+ * @brief 清空堆 (O(size))
+ */
+void daryHeapReset(DaryHeap* H);
+
+/**
+ * @brief 插入顶点 (调用者保证 value 当前不在堆中)
+ */
+void daryHeapInsert(DaryHeap* H, long long key, int value);
+
+/**
+ * @brief 提取最小键的顶点
+ * @return 顶点ID, 堆为空时返回 -1
+ */
+int daryHeapExtractMin(DaryHeap* H);
+
+/**
+ * @brief 减小堆中顶点的键值 (顶点不在堆中时不做任何事)
+ */
+void daryHeapDecreaseKey(DaryHeap* H, int value, long long newKey);
+
+/**
+ * @brief 检查顶点是否在堆中
+ */
+static inline int daryHeapContains(const DaryHeap* H, int value) {
+    return H->pos[value] >= 0;
+}
+
+/**
+ * @brief 检查堆是否为空
+ */
+static inline int daryHeapIsEmpty(const DaryHeap* H) {
+    return H->size == 0;
+}
+
+/**
+ * @brief 查看最小键 (不提取), 堆为空时返回 LLONG_MAX
+ *
+ * 根 (逻辑下标 0) 位于物理槽 d - 1, 空堆时该槽本身就是 LLONG_MAX。
+ */
+static inline long long daryHeapMinKey(const DaryHeap* H) {
+    return H->keys[DARY_HEAP_D - 1];
+}
+
+#endif // DARY_HEAP_H
@@ -0,0 +1,360 @@
+#define _POSIX_C_SOURCE 200809L // pthread_barrier
+
+#include "DeltaStepping.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 每次从工作数组中领取的顶点数
+#define DELTA_STEPPING_CHUNK 64
+// 工作量小于此值的阶段由调用线程单独完成, 不唤醒线程池
+#define DELTA_STEPPING_PARALLEL_MIN 512
+// 自动选择桶宽时最多抽样的边数
+#define DELTA_STEPPING_SAMPLE 65536
+
+// 内部函数: 向可增长数组追加一个顶点
+static int pushVertex(int** items, int* size, int* capacity, int v) {
+    if (*size == *capacity) {
+        int newCap = *capacity > 0 ? *capacity * 2 : 256;
+        int* grown = (int*)realloc(*items, newCap * sizeof(int));
+        if (grown == NULL) {
+            perror("错误: 无法扩展 delta-stepping 缓冲区");
+            return -1;
+        }
+        *items = grown;
+        *capacity = newCap;
+    }
+    (*items)[(*size)++] = v;
+    return 0;
+}
+
+// 内部函数: 原子地把 dist[v] 降为 nd, 成功 (确实变小) 时返回 1
+static inline int atomicMin(long long* slot, long long nd) {
+    long long old = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    while (nd < old) {
+        if (__atomic_compare_exchange_n(slot, &old, nd, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 松弛本阶段工作数组中的顶点 (每个线程动态领取若干块)
+ */
+static void relaxWork(DeltaSteppingContext* ctx, DeltaSteppingWorker* w) {
+    const int* offsets = ctx->g->offsets;
+    const int* lightEnd = ctx->lightEnd;
+    const int* targets = ctx->targets;
+    const int* weights = ctx->weights;
+    long long* dist = ctx->dist;
+    const int* work = ctx->work;
+    int workSize = ctx->workSize;
+    int heavy = ctx->heavyPhase;
+
+    for (;;) {
+        int begin = __atomic_fetch_add(&ctx->nextIndex, DELTA_STEPPING_CHUNK, __ATOMIC_RELAXED);
+        if (begin >= workSize) break;
+        int end = begin + DELTA_STEPPING_CHUNK < workSize ? begin + DELTA_STEPPING_CHUNK : workSize;
+        for (int i = begin; i < end; ++i) {
+            int u = work[i];
+            // 轻边阶段中 dist[u] 可能被其他线程继续减小; 读到哪个值都正确, 更小的值会让 u 再次入桶
+            long long du = __atomic_load_n(&dist[u], __ATOMIC_RELAXED);
+            int eBegin = heavy ? lightEnd[u] : offsets[u];
+            int eEnd = heavy ? offsets[u + 1] : lightEnd[u];
+            for (int e = eBegin; e < eEnd; ++e) {
+                int v = targets[e];
+                if (atomicMin(&dist[v], du + weights[e]) &&
+                    pushVertex(&w->out, &w->outSize, &w->outCapacity, v) != 0) {
+                    // 丢掉这个顶点会使它永远不被确定; 标记失败, 由调用线程让整个查询失败
+                    __atomic_store_n(&ctx->failed, 1, __ATOMIC_RELAXED);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// 内部函数: 线程池中的工作线程 (1..numThreads-1)
+static void* workerMain(void* arg) {
+    DeltaSteppingWorker* w = (DeltaSteppingWorker*)arg;
+    DeltaSteppingContext* ctx = w->ctx;
+    // 等待创建者确定线程数并初始化屏障
+    pthread_mutex_lock(&ctx->startGate);
+    pthread_mutex_unlock(&ctx->startGate);
+    for (;;) {
+        pthread_barrier_wait(&ctx->startBarrier);
+        if (ctx->exitFlag) break;
+        relaxWork(ctx, w);
+        pthread_barrier_wait(&ctx->doneBarrier);
+    }
+    return NULL;
+}
+
+// 内部函数: 取一个新的去重标记值 (回绕时清零两个标记数组)
+static unsigned int nextStamp(DeltaSteppingContext* ctx) {
+    if (++ctx->stampId == 0) {
+        size_t n = (size_t)ctx->g->numVertices + 1;
+        memset(ctx->mark, 0, n * sizeof(unsigned int));
+        memset(ctx->settledMark, 0, n * sizeof(unsigned int));
+        ctx->stampId = 1;
+    }
+    return ctx->stampId;
+}
+
+/**
+ * @brief 执行一个松弛阶段, 再把所有被改进的顶点按新距离合并进桶
+ */
+static int runPhase(DeltaSteppingContext* ctx, const int* work, int workSize, int heavy) {
+    ctx->work = work;
+    ctx->workSize = workSize;
+    ctx->heavyPhase = heavy;
+    ctx->nextIndex = 0;
+
+    int parallel = ctx->numThreads > 1 && workSize >= DELTA_STEPPING_PARALLEL_MIN;
+    int active = parallel ? ctx->numThreads : 1;
+    if (parallel) pthread_barrier_wait(&ctx->startBarrier);
+    relaxWork(ctx, &ctx->workers[0]);
+    if (parallel) pthread_barrier_wait(&ctx->doneBarrier);
+    if (ctx->failed) return -1;
+
+    unsigned int stamp = nextStamp(ctx);
+    for (int t = 0; t < active; ++t) {
+        DeltaSteppingWorker* w = &ctx->workers[t];
+        for (int i = 0; i < w->outSize; ++i) {
+            int v = w->out[i];
+            if (ctx->mark[v] == stamp) continue;
+            ctx->mark[v] = stamp;
+            DeltaBucket* b = &ctx->buckets[(ctx->dist[v] / ctx->delta) % ctx->numBuckets];
+            if (pushVertex(&b->items, &b->size, &b->capacity, v) != 0) return -1;
+        }
+        w->outSize = 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief 创建 delta-stepping 上下文
+ */
+DeltaSteppingContext* createDeltaSteppingContext(const Graph* g, long long delta, int numThreads) {
+    DeltaSteppingContext* ctx = (DeltaSteppingContext*)calloc(1, sizeof(DeltaSteppingContext));
+    if (ctx == NULL) {
+        perror("错误: 无法为 delta-stepping 上下文分配内存");
+        return NULL;
+    }
+    int V = g->numVertices;
+    int E = g->numEdges;
+    ctx->g = g;
+    ctx->delta = delta > 0 ? delta : deltaSteppingAutoDelta(g);
+    ctx->numThreads = numThreads > 0 ? numThreads : 1;
+
+    ctx->lightEnd = (int*)malloc((V + 1) * sizeof(int));
+    ctx->targets = (int*)malloc((E > 0 ? E : 1) * sizeof(int));
+    ctx->weights = (int*)malloc((E > 0 ? E : 1) * sizeof(int));
+    ctx->dist = (long long*)malloc((V + 1) * sizeof(long long));
+    ctx->settled = (int*)malloc((V + 1) * sizeof(int));
+    ctx->frontier = (int*)malloc((V + 1) * sizeof(int));
+    ctx->mark = (unsigned int*)calloc(V + 1, sizeof(unsigned int));
+    ctx->settledMark = (unsigned int*)calloc(V + 1, sizeof(unsigned int));
+    ctx->workers = (DeltaSteppingWorker*)calloc(ctx->numThreads, sizeof(DeltaSteppingWorker));
+    if (ctx->lightEnd == NULL || ctx->targets == NULL || ctx->weights == NULL || ctx->dist == NULL ||
+        ctx->settled == NULL || ctx->frontier == NULL || ctx->mark == NULL ||
+        ctx->settledMark == NULL || ctx->workers == NULL) {
+        perror("错误: 无法为 delta-stepping 数组分配内存");
+        deltaSteppingContextDestroy(ctx);
+        return NULL;
+    }
+
+    // 每个顶点的边按轻 / 重稳定划分, 轻边在前
+    int maxWeight = 0;
+    for (int u = 0; u <= V; ++u) {
+        int k = g->offsets[u];
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            if (g->weights[e] <= ctx->delta) {
+                ctx->targets[k] = g->targets[e];
+                ctx->weights[k] = g->weights[e];
+                k++;
+            }
+            if (g->weights[e] > maxWeight) maxWeight = g->weights[e];
+        }
+        ctx->lightEnd[u] = k;
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            if (g->weights[e] > ctx->delta) {
+                ctx->targets[k] = g->targets[e];
+                ctx->weights[k] = g->weights[e];
+                k++;
+            }
+        }
+    }
+
+    // 未确定的顶点都在 [当前桶, 当前桶 + maxWeight/delta + 1] 之内, 循环使用这么多个桶即可
+    ctx->numBuckets = (int)(maxWeight / ctx->delta) + 2;
+    ctx->buckets = (DeltaBucket*)calloc(ctx->numBuckets, sizeof(DeltaBucket));
+    if (ctx->buckets == NULL) {
+        perror("错误: 无法为 delta-stepping 桶分配内存");
+        deltaSteppingContextDestroy(ctx);
+        return NULL;
+    }
+
+    for (int v = 0; v <= V; ++v) ctx->dist[v] = DIJKSTRA_INF;
+
+    // 启动线程池 (第 0 号工作线程就是调用线程)
+    for (int t = 0; t < ctx->numThreads; ++t) {
+        ctx->workers[t].ctx = ctx;
+    }
+    if (ctx->numThreads > 1) {
+        pthread_mutex_init(&ctx->startGate, NULL);
+        pthread_mutex_lock(&ctx->startGate);
+        int started = 1;
+        while (started < ctx->numThreads &&
+               pthread_create(&ctx->workers[started].thread, NULL, workerMain, &ctx->workers[started]) == 0) {
+            started++;
+        }
+        if (started < ctx->numThreads) {
+            fprintf(stderr, "警告: 只创建了 %d 个 delta-stepping 工作线程。\n", started);
+            ctx->numThreads = started;
+        }
+        if (ctx->numThreads > 1) {
+            pthread_barrier_init(&ctx->startBarrier, NULL, ctx->numThreads);
+            pthread_barrier_init(&ctx->doneBarrier, NULL, ctx->numThreads);
+        }
+        pthread_mutex_unlock(&ctx->startGate);
+    }
+    return ctx;
+}
+
+/**
+ * @brief 销毁上下文
+ */
+void deltaSteppingContextDestroy(DeltaSteppingContext* ctx) {
+    if (ctx == NULL) return;
+    if (ctx->numThreads > 1 && ctx->workers != NULL && ctx->buckets != NULL) {
+        ctx->exitFlag = 1;
+        pthread_barrier_wait(&ctx->startBarrier);
+        for (int t = 1; t < ctx->numThreads; ++t) {
+            pthread_join(ctx->workers[t].thread, NULL);
+        }
+        pthread_barrier_destroy(&ctx->startBarrier);
+        pthread_barrier_destroy(&ctx->doneBarrier);
+        pthread_mutex_destroy(&ctx->startGate);
+    }
+    if (ctx->workers != NULL) {
+        for (int t = 0; t < ctx->numThreads; ++t) free(ctx->workers[t].out);
+    }
+    if (ctx->buckets != NULL) {
+        for (int b = 0; b < ctx->numBuckets; ++b) free(ctx->buckets[b].items);
+    }
+    free(ctx->buckets);
+    free(ctx->workers);
+    free(ctx->lightEnd);
+    free(ctx->targets);
+    free(ctx->weights);
+    free(ctx->dist);
+    free(ctx->settled);
+    free(ctx->frontier);
+    free(ctx->mark);
+    free(ctx->settledMark);
+    free(ctx);
+}
+
+// 内部函数: 查询中途失败时清空桶和距离, 使上下文可以继续用于下一次查询
+static int abortQuery(DeltaSteppingContext* ctx) {
+    for (int t = 0; t < ctx->numThreads; ++t) ctx->workers[t].outSize = 0;
+    for (int b = 0; b < ctx->numBuckets; ++b) ctx->buckets[b].size = 0;
+    // 被改进但尚未确定的顶点不在 settled 中, 只能整体重置
+    for (int v = 0; v <= ctx->g->numVertices; ++v) ctx->dist[v] = DIJKSTRA_INF;
+    ctx->numSettled = 0;
+    ctx->failed = 0;
+    return -1;
+}
+
+/**
+ * @brief 执行一次单源最短路查询
+ */
+int deltaSteppingRun(DeltaSteppingContext* ctx, int source) {
+    if (source <= 0 || source > ctx->g->numVertices) {
+        fprintf(stderr, "错误: 起始节点 %d 无效。\n", source);
+        return -1;
+    }
+
+    // 只重置上一次查询到达过的顶点
+    for (int i = 0; i < ctx->numSettled; ++i) {
+        ctx->dist[ctx->settled[i]] = DIJKSTRA_INF;
+    }
+    ctx->numSettled = 0;
+
+    long long delta = ctx->delta;
+    int numBuckets = ctx->numBuckets;
+    ctx->dist[source] = 0;
+    DeltaBucket* first = &ctx->buckets[0];
+    if (pushVertex(&first->items, &first->size, &first->capacity, source) != 0) return abortQuery(ctx);
+
+    // 依次处理桶号 cur; 连续 numBuckets 个桶为空时所有顶点都已确定
+    long long cur = 0;
+    int emptyRun = 0;
+    while (emptyRun < numBuckets) {
+        DeltaBucket* b = &ctx->buckets[cur % numBuckets];
+        if (b->size == 0) {
+            cur++;
+            emptyRun++;
+            continue;
+        }
+        emptyRun = 0;
+
+        unsigned int settledStamp = nextStamp(ctx);
+        int bucketStart = ctx->numSettled;
+
+        // 轻边阶段: 反复取出桶中 (非过期) 顶点松弛轻边, 直到桶不再有新顶点
+        while (b->size > 0) {
+            unsigned int stamp = nextStamp(ctx);
+            int frontierSize = 0;
+            for (int i = 0; i < b->size; ++i) {
+                int v = b->items[i];
+                if (ctx->dist[v] / delta != cur) continue; // 过期: 已移到更小的桶
+                if (ctx->mark[v] == stamp) continue;
+                ctx->mark[v] = stamp;
+                ctx->frontier[frontierSize++] = v;
+                if (ctx->settledMark[v] != settledStamp) {
+                    ctx->settledMark[v] = settledStamp;
+                    ctx->settled[ctx->numSettled++] = v;
+                }
+            }
+            b->size = 0;
+            if (frontierSize > 0 && runPhase(ctx, ctx->frontier, frontierSize, 0) != 0) return abortQuery(ctx);
+        }
+
+        // 重边阶段: 本桶确定的每个顶点松弛一次重边 (结果都落在更大的桶)
+        int bucketSettled = ctx->numSettled - bucketStart;
+        if (bucketSettled > 0 &&
+            runPhase(ctx, ctx->settled + bucketStart, bucketSettled, 1) != 0) return abortQuery(ctx);
+        cur++;
+    }
+    return ctx->numSettled;
+}
+
+// 内部函数: qsort 比较函数
+static int compareInt(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 根据边权分布选择桶宽
+ */
+long long deltaSteppingAutoDelta(const Graph* g) {
+    int E = g->numEdges;
+    if (E == 0) return 1;
+    int n = E < DELTA_STEPPING_SAMPLE ? E : DELTA_STEPPING_SAMPLE;
+    int* sample = (int*)malloc(n * sizeof(int));
+    if (sample == NULL) return 1;
+    long long stride = E / n;
+    for (int i = 0; i < n; ++i) {
+        sample[i] = g->weights[i * stride];
+    }
+    qsort(sample, n, sizeof(int), compareInt);
+    long long delta = (long long)sample[n / 2] * DELTA_STEPPING_AUTO_FACTOR;
+    free(sample);
+    return delta > 0 ? delta : 1;
+}
@@ -0,0 +1,122 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <pthread.h>
+
+#include "Graph.h"
+#include "Dijkstra.h" // DIJKSTRA_INF
+
+/**
+ * @brief 一个桶 (顶点ID的可增长数组, 允许包含过期条目)
+ */
+typedef struct DeltaBucket {
+    int* items;
+    int size;
+    int capacity;
+} DeltaBucket;
+
+typedef struct DeltaSteppingContext DeltaSteppingContext;
+
+/**
+ * @brief 工作线程私有状态: 本阶段距离被改进的顶点
+ */
+typedef struct DeltaSteppingWorker {
+    DeltaSteppingContext* ctx;
+    pthread_t thread;
+    int* out;
+    int outSize;
+    int outCapacity;
+} DeltaSteppingWorker;
+
+/**
+ * @brief Delta-stepping 单源最短路 (并行) 的查询上下文
+ *
+ * 顶点按 floor(dist / delta) 放入桶中, 从小到大处理每个桶:
+ * 先反复并行松弛桶内顶点的轻边 (w <= delta, 可能把顶点放回同一个桶),
+ * 桶稳定后再对该桶确定的所有顶点并行松弛一次重边 (w > delta)。
+ * 距离数组用原子 CAS 取最小值更新; 每个阶段结束后由调用线程把被改进的顶点
+ * 合并进桶。结果与 Dijkstra 完全相同。
+ *
+ * 每个顶点的边在创建时按轻 / 重重新排列 (轻边在前), 松弛时不再判断权重。
+ * 线程池在上下文中常驻, 跨查询复用; 调用线程本身是第 0 号工作线程。
+ * 与 DijkstraContext 一样, 一个上下文同一时间只能执行一个查询。
+ */
+struct DeltaSteppingContext {
+    const Graph* g;
+    long long delta;          // 桶宽
+    int numThreads;
+
+    // --- 轻边在前的边数组 ---
+    int* lightEnd;            // 顶点 u 的轻边为 [offsets[u], lightEnd[u]), 重边为 [lightEnd[u], offsets[u+1])
+    int* targets;
+    int* weights;
+
+    // --- 查询状态 ---
+    long long* dist;          // 距离 (并行阶段中原子更新), 未到达为 DIJKSTRA_INF
+    int* settled;             // 本次查询确定的顶点, 按桶顺序; 也用于下次查询前的重置
+    int numSettled;
+    int* frontier;            // 当前轻边阶段的顶点
+    unsigned int* mark;       // 去重标记 (合并 / 取桶时)
+    unsigned int* settledMark;// 每个桶内确定集合的去重标记
+    unsigned int stampId;
+    DeltaBucket* buckets;     // 循环桶数组
+    int numBuckets;           // maxWeight / delta + 2
+
+    // --- 线程池 ---
+    DeltaSteppingWorker* workers;
+    pthread_mutex_t startGate;    // 创建线程期间持有, 确定实际线程数后才初始化屏障
+    pthread_barrier_t startBarrier;
+    pthread_barrier_t doneBarrier;
+    const int* work;          // 本阶段要松弛的顶点
+    int workSize;
+    int heavyPhase;           // 0: 松弛轻边, 1: 松弛重边
+    int exitFlag;
+    int nextIndex;            // 工作分配游标 (原子递增)
+    int failed;               // 本阶段有线程无法扩展缓冲区 (原子置位)
+};
+
+/**
+ * @brief 创建 delta-stepping 上下文 (重排边数组并启动线程池)
+ * @param g 图 (只读, 可被多个上下文共享)
+ * @param delta 桶宽, <= 0 表示使用 deltaSteppingAutoDelta(g)
+ * @param numThreads 线程数 (<= 0 表示 1; 线程创建失败时按实际创建的数目运行)
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+DeltaSteppingContext* createDeltaSteppingContext(const Graph* g, long long delta, int numThreads);
+
+/**
+ * @brief 销毁上下文 (停止并回收线程池)
+ */
+void deltaSteppingContextDestroy(DeltaSteppingContext* ctx);
+
+/**
+ * @brief 执行一次单源最短路查询
+ *
+ * 结果用 deltaSteppingGetDist 读取, 直到下一次查询为止有效。
+ * @param ctx 上下文
+ * @param source 起始顶点ID
+ * @return 确定的 (可达的) 顶点数, 起点无效或内存分配失败时返回 -1 (上下文仍可继续使用)
+ */
+int deltaSteppingRun(DeltaSteppingContext* ctx, int source);
+
+/**
+ * @brief 根据边权分布选择桶宽
+ *
+ * 取边权中位数 (大图上均匀抽样) 的 DELTA_STEPPING_AUTO_FACTOR 倍:
+ * 桶宽太小, 每个桶的并行度低且阶段数多; 太大, 轻边阶段的重复松弛变多。
+ * @param g 图
+ * @return 建议的桶宽 (>= 1)
+ */
+long long deltaSteppingAutoDelta(const Graph* g);
+
+// deltaSteppingAutoDelta 使用的中位数倍数
+#define DELTA_STEPPING_AUTO_FACTOR 6
+
+/**
+ * @brief 读取最近一次查询的距离
+ */
+static inline long long deltaSteppingGetDist(const DeltaSteppingContext* ctx, int v) {
+    return ctx->dist[v];
+}
+
+#endif // DELTA_STEPPING_H
@@ -0,0 +1,292 @@
+#include "Dijkstra.h"
+#include "DijkstraKernel.h"
+
+#include <string.h>
+
+// --- 特化内核 (每种队列各一组) ---
+
+#define DIJKSTRA_DEFINE_QUEUE_KERNELS(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY,                        \
+                                      RESET, PUSH, DECREASE, POP, EMPTY, MINKEY)                     \
+    DIJKSTRA_DEFINE_KERNEL(kernel##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY)               \
+    DIJKSTRA_DEFINE_TARGET_SET_KERNEL(targets##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY)   \
+    DIJKSTRA_DEFINE_RADIUS_KERNEL(radius##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY)        \
+    DIJKSTRA_DEFINE_BIDIRECTIONAL_KERNEL(bidir##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY,  \
+                                         MINKEY)
+
+DIJKSTRA_QUEUE_LIST(DIJKSTRA_DEFINE_QUEUE_KERNELS)
+
+#undef DIJKSTRA_DEFINE_QUEUE_KERNELS
+
+/**
+ * @brief 创建查询上下文 (斐波那契堆)
+ */
+DijkstraContext* createDijkstraContext(const Graph* g) {
+    return createDijkstraContextWithQueue(g, PQ_FIBONACCI);
+}
+
+/**
+ * @brief 创建使用指定优先队列的查询上下文
+ */
+DijkstraContext* createDijkstraContextWithQueue(const Graph* g, PriorityQueueKind kind) {
+    DijkstraContext* ctx = (DijkstraContext*)malloc(sizeof(DijkstraContext));
+    if (ctx == NULL) {
+        perror("错误: 无法为查询上下文分配内存");
+        return NULL;
+    }
+    ctx->g = g;
+    ctx->epoch = 0;
+    ctx->kind = kind;
+    ctx->pq = NULL;
+    ctx->source = 0;
+    ctx->numSettled = 0;
+    ctx->targetStamp = NULL;
+    ctx->reached = NULL;
+    ctx->reachedCapacity = 0;
+
+    // calloc: 所有 stamp 为 0, 与 epoch 0 对应的 "无查询" 状态一致
+    ctx->state = (DijkstraVertexState*)calloc(g->numVertices + 1, sizeof(DijkstraVertexState));
+    switch (kind) {
+#define CREATE_CASE(KIND, SUFFIX, QUEUE_T, CREATE, ...) \
+        case KIND: ctx->pq = CREATE(g->numVertices + 1); break;
+        DIJKSTRA_QUEUE_LIST(CREATE_CASE)
+#undef CREATE_CASE
+        default: break;
+    }
+    if (ctx->state == NULL || (ctx->pq == NULL && kind != PQ_KIND_COUNT)) {
+        perror("错误: 无法为查询状态分配内存");
+        dijkstraContextDestroy(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+/**
+ * @brief 创建不带优先队列的查询上下文
+ */
+DijkstraContext* createDijkstraContextWithoutQueue(const Graph* g) {
+    return createDijkstraContextWithQueue(g, PQ_KIND_COUNT);
+}
+
+/**
+ * @brief 销毁查询上下文
+ */
+void dijkstraContextDestroy(DijkstraContext* ctx) {
+    if (ctx == NULL) return;
+    free(ctx->state);
+    free(ctx->targetStamp);
+    free(ctx->reached);
+    switch (ctx->kind) {
+#define DESTROY_CASE(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY, ...) \
+        case KIND: DESTROY((QUEUE_T*)ctx->pq); break;
+        DIJKSTRA_QUEUE_LIST(DESTROY_CASE)
+#undef DESTROY_CASE
+        default: break;
+    }
+    free(ctx);
+}
+
+/**
+ * @brief 开始一次新查询
+ */
+void dijkstraBeginQuery(DijkstraContext* ctx, int source) {
+    ctx->epoch++;
+    if (ctx->epoch == 0) {
+        for (int i = 0; i <= ctx->g->numVertices; ++i) ctx->state[i].stamp = 0;
+        if (ctx->targetStamp != NULL) {
+            memset(ctx->targetStamp, 0, (ctx->g->numVertices + 1) * sizeof(unsigned int));
+        }
+        ctx->epoch = 1;
+    }
+    ctx->source = source;
+    ctx->numSettled = 0;
+}
+
+// 内部函数：检查起点
+static int checkSource(const DijkstraContext* ctx, int startNode) {
+    if (startNode <= 0 || startNode > ctx->g->numVertices) {
+        fprintf(stderr, "错误: 起始节点 %d 无效。\n", startNode);
+        return -1;
+    }
+    return 0;
+}
+
+// 内部函数: 按队列种类分派到特化内核
+static int runKernel(DijkstraContext* ctx, int source, int target) {
+    switch (ctx->kind) {
+#define KERNEL_CASE(KIND, SUFFIX, QUEUE_T, ...) \
+        case KIND: return kernel##SUFFIX(ctx, (QUEUE_T*)ctx->pq, source, target);
+        DIJKSTRA_QUEUE_LIST(KERNEL_CASE)
+#undef KERNEL_CASE
+        default: return -1;
+    }
+}
+
+/**
+ * @brief 按上下文的队列种类分派到特化内核
+ */
+int dijkstraRun(DijkstraContext* ctx, int startNode) {
+    if (checkSource(ctx, startNode) != 0) return -1;
+    return runKernel(ctx, startNode, 0);
+}
+
+/**
+ * @brief 使用斐波那契堆实现Dijkstra算法
+ */
+int dijkstra_fib_heap(DijkstraContext* ctx, int startNode) {
+    if (ctx->kind != PQ_FIBONACCI) {
+        fprintf(stderr, "错误: 查询上下文未使用斐波那契堆。\n");
+        return -1;
+    }
+    if (checkSource(ctx, startNode) != 0) return -1;
+    return kernelFib(ctx, (FibHeap*)ctx->pq, startNode, 0);
+}
+
+/**
+ * @brief 单向点对点查询: target 出队即停止
+ */
+long long dijkstraPointToPoint(DijkstraContext* ctx, int source, int target) {
+    if (checkSource(ctx, source) != 0 || checkSource(ctx, target) != 0) return -1;
+    runKernel(ctx, source, target);
+    return dijkstraGetDist(ctx, target);
+}
+
+/**
+ * @brief 开始目标集合查询: 标记终点
+ */
+int dijkstraBeginTargetSet(DijkstraContext* ctx, int source, const int* targets, int numTargets) {
+    if (checkSource(ctx, source) != 0) return -1;
+    for (int i = 0; i < numTargets; ++i) {
+        if (checkSource(ctx, targets[i]) != 0) return -1;
+    }
+    if (ctx->targetStamp == NULL) {
+        ctx->targetStamp = (unsigned int*)calloc(ctx->g->numVertices + 1, sizeof(unsigned int));
+        if (ctx->targetStamp == NULL) {
+            perror("错误: 无法为目标集合分配内存");
+            return -1;
+        }
+    }
+
+    // 先开始查询 (epoch 回绕时清零标记), 再按新的 epoch 标记终点; 内核不会再次开始查询
+    dijkstraBeginQuery(ctx, source);
+    const unsigned int epoch = ctx->epoch;
+    int remaining = 0;
+    for (int i = 0; i < numTargets; ++i) {
+        if (ctx->targetStamp[targets[i]] != epoch) {
+            ctx->targetStamp[targets[i]] = epoch;
+            remaining++;
+        }
+    }
+    return remaining;
+}
+
+/**
+ * @brief 目标集合查询: 终点全部确定 (或超过距离上限) 即停止
+ */
+int dijkstraTargetSet(DijkstraContext* ctx, int source, const int* targets, int numTargets,
+                      long long maxDist, long long* dist) {
+    int remaining = dijkstraBeginTargetSet(ctx, source, targets, numTargets);
+    if (remaining < 0) return -1;
+    if (maxDist < 0) maxDist = DIJKSTRA_INF;
+
+    int settled;
+    switch (ctx->kind) {
+#define TARGETS_CASE(KIND, SUFFIX, QUEUE_T, ...) \
+        case KIND: settled = targets##SUFFIX(ctx, (QUEUE_T*)ctx->pq, source, remaining, maxDist); break;
+        DIJKSTRA_QUEUE_LIST(TARGETS_CASE)
+#undef TARGETS_CASE
+        default: return -1;
+    }
+
+    // 停止时所有终点要么已确定, 要么距离超过了 maxDist (堆已空时暂定距离也是最终距离)
+    for (int i = 0; i < numTargets; ++i) {
+        long long d = dijkstraGetDist(ctx, targets[i]);
+        dist[i] = d <= maxDist ? d : DIJKSTRA_INF;
+    }
+    return settled;
+}
+
+/**
+ * @brief 扩大有界查询的结果缓冲区
+ */
+int dijkstraReserveReached(DijkstraContext* ctx, int capacity) {
+    if (capacity <= ctx->reachedCapacity) return 0;
+    int grown = ctx->reachedCapacity > 0 ? ctx->reachedCapacity : 256;
+    while (grown < capacity) grown *= 2;
+    DijkstraReached* reached = (DijkstraReached*)realloc(ctx->reached, grown * sizeof(DijkstraReached));
+    if (reached == NULL) {
+        perror("错误: 无法为有界查询结果分配内存");
+        return -1;
+    }
+    ctx->reached = reached;
+    ctx->reachedCapacity = grown;
+    return 0;
+}
+
+/**
+ * @brief 有界查询 (等时圈)
+ */
+int dijkstraWithinRadius(DijkstraContext* ctx, int source, long long radius, const DijkstraReached** reached) {
+    if (checkSource(ctx, source) != 0) return -1;
+    if (radius < 0) {
+        fprintf(stderr, "错误: 半径不能为负数。\n");
+        return -1;
+    }
+    int count;
+    switch (ctx->kind) {
+#define RADIUS_CASE(KIND, SUFFIX, QUEUE_T, ...) \
+        case KIND: count = radius##SUFFIX(ctx, (QUEUE_T*)ctx->pq, source, radius); break;
+        DIJKSTRA_QUEUE_LIST(RADIUS_CASE)
+#undef RADIUS_CASE
+        default: return -1;
+    }
+    if (reached != NULL) *reached = ctx->reached;
+    return count;
+}
+
+/**
+ * @brief 创建双向查询上下文
+ */
+BidirectionalContext* createBidirectionalContext(const Graph* g, PriorityQueueKind kind) {
+    if (g->reverse == NULL) {
+        fprintf(stderr, "错误: 双向搜索需要反向图 (先调用 graphBuildReverse)。\n");
+        return NULL;
+    }
+    BidirectionalContext* bc = (BidirectionalContext*)malloc(sizeof(BidirectionalContext));
+    if (bc == NULL) {
+        perror("错误: 无法为双向查询上下文分配内存");
+        return NULL;
+    }
+    bc->forward = createDijkstraContextWithQueue(g, kind);
+    bc->backward = createDijkstraContextWithQueue(g->reverse, kind);
+    bc->meetVertex = 0;
+    bc->numSettled = 0;
+    if (bc->forward == NULL || bc->backward == NULL) {
+        bidirectionalContextDestroy(bc);
+        return NULL;
+    }
+    return bc;
+}
+
+/**
+ * @brief 销毁双向查询上下文
+ */
+void bidirectionalContextDestroy(BidirectionalContext* bc) {
+    if (bc == NULL) return;
+    dijkstraContextDestroy(bc->forward);
+    dijkstraContextDestroy(bc->backward);
+    free(bc);
+}
+
+/**
+ * @brief 双向 Dijkstra 点对点查询
+ */
+long long dijkstraBidirectional(BidirectionalContext* bc, int source, int target) {
+    if (checkSource(bc->forward, source) != 0 || checkSource(bc->forward, target) != 0) return -1;
+    switch (bc->forward->kind) {
+#define BIDIR_CASE(KIND, SUFFIX, ...) \
+        case KIND: return bidir##SUFFIX(bc, source, target);
+        DIJKSTRA_QUEUE_LIST(BIDIR_CASE)
+#undef BIDIR_CASE
+        default: return -1;
+    }
+}
@@ -0,0 +1,215 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <limits.h> // for LLONG_MAX
+
+#include "Graph.h"
+#include "FibonacciHeap.h"
+#include "BinaryHeap.h"
+#include "RadixHeap.h"
+#include "PairingHeap.h"
+#include "DaryHeap.h"
+#include "IndexedFibHeap.h"
+#include "PriorityQueue.h"
+
+// 定义无穷大 (不可达)
+#define DIJKSTRA_INF LLONG_MAX
+
+/**
+ * @brief 每个顶点的查询状态 (放在同一结构体中, 松弛时一次缓存访问)
+ *
+ * 只有当 stamp == 上下文的 epoch 时, dist 和 node 才属于当前查询;
+ * 否则视为 dist = INF, node = NULL。
+ */
+typedef struct DijkstraVertexState {
+    long long dist;       // 当前最短距离
+    FibHeapNode* node;    // 斐波那契堆中的节点 (已提取或未入堆时为 NULL; 其他队列不使用)
+    unsigned int stamp;   // 最后一次被触及的查询编号
+} DijkstraVertexState;
+
+/**
+ * @brief 有界查询 (等时圈) 的结果项
+ */
+typedef struct DijkstraReached {
+    int vertex;
+    long long dist;
+} DijkstraReached;
+
+/**
+ * @brief 可复用的Dijkstra查询上下文
+ *
+ * 每个线程创建一个, 跨查询复用。通过查询编号 (epoch) 实现惰性重置:
+ * 新查询只需 epoch++, 一次查询的开销只与它实际触及的顶点数有关, 而与 V 无关。
+ */
+typedef struct DijkstraContext {
+    const Graph* g;
+    DijkstraVertexState* state;  // 长度 numVertices + 1
+    unsigned int epoch;          // 当前查询编号
+    PriorityQueueKind kind;      // 使用的优先队列
+    void* pq;                    // 复用的优先队列 (类型由 kind 决定, 容量 V+1)
+    int source;                  // 最近一次查询的起点
+    int numSettled;              // 最近一次查询确定 (提取) 的顶点数
+    unsigned int* targetStamp;   // 目标集合查询: 等于 epoch 表示尚未确定的终点 (首次使用时分配)
+    DijkstraReached* reached;    // 有界查询: 确定的顶点, 按距离升序 (按需扩容, 跨查询复用)
+    int reachedCapacity;
+} DijkstraContext;
+
+/**
+ * @brief 创建查询上下文 (使用斐波那契堆)
+ * @param g 图 (只读, 可被多个上下文共享)
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+DijkstraContext* createDijkstraContext(const Graph* g);
+
+/**
+ * @brief 创建使用指定优先队列的查询上下文
+ * @param g 图 (只读, 可被多个上下文共享)
+ * @param kind 优先队列种类
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+DijkstraContext* createDijkstraContextWithQueue(const Graph* g, PriorityQueueKind kind);
+
+/**
+ * @brief 创建不带优先队列的查询上下文 (kind 为 PQ_KIND_COUNT)
+ *
+ * 供自带队列、直接用 DijkstraKernel.h 的内核模板实例化内核的调用者使用;
+ * 按 kind 分派的查询函数 (dijkstraRun、dijkstraTargetSet 等) 对这种上下文返回 -1。
+ * @param g 图 (只读, 可被多个上下文共享)
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+DijkstraContext* createDijkstraContextWithoutQueue(const Graph* g);
+
+/**
+ * @brief 销毁查询上下文
+ * @param ctx 上下文
+ */
+void dijkstraContextDestroy(DijkstraContext* ctx);
+
+/**
+ * @brief 一对多Dijkstra, 使用上下文所选的优先队列 (每次查询只分派一次)
+ *
+ * 结果保存在上下文中, 用 dijkstraGetDist 读取, 直到下一次查询为止有效。
+ *
+ * @param ctx 查询上下文
+ * @param startNode 起始顶点ID
+ * @return 确定的顶点数, 起点无效时返回 -1
+ */
+int dijkstraRun(DijkstraContext* ctx, int startNode);
+
+/**
+ * @brief 使用斐波那契堆实现Dijkstra算法 (要求上下文使用 PQ_FIBONACCI)
+ * @return 确定的顶点数, 起点无效或队列不匹配时返回 -1
+ */
+int dijkstra_fib_heap(DijkstraContext* ctx, int startNode);
+
+/**
+ * @brief 单向点对点查询: 与 dijkstraRun 相同, 但 target 的距离确定后立即停止
+ * @param ctx 查询上下文
+ * @param source 起点
+ * @param target 终点
+ * @return 最短距离 (不可达时为 DIJKSTRA_INF), 顶点无效时返回 -1;
+ *         ctx->numSettled 为确定的顶点数
+ */
+long long dijkstraPointToPoint(DijkstraContext* ctx, int source, int target);
+
+/**
+ * @brief 目标集合查询: 所有终点的距离确定后立即停止, 只返回这些终点的距离
+ *
+ * 给出 maxDist 时, 堆顶距离超过 maxDist 也会停止, 更远的终点视为不可达。
+ * 一对多查询 (dijkstraRun / dijkstra_fib_heap) 不受影响。
+ *
+ * @param ctx 查询上下文
+ * @param source 起点
+ * @param targets 终点数组 (可以重复)
+ * @param numTargets 终点数
+ * @param maxDist 距离上限, < 0 表示不限
+ * @param dist 输出: dist[i] 为到 targets[i] 的最短距离, 不可达或超过上限时为 DIJKSTRA_INF
+ * @return 确定的顶点数, 顶点无效时返回 -1
+ */
+int dijkstraTargetSet(DijkstraContext* ctx, int source, const int* targets, int numTargets,
+                      long long maxDist, long long* dist);
+
+/**
+ * @brief 有界查询 (等时圈): 只计算距离 <= radius 的顶点, 返回紧凑的 (顶点, 距离) 列表
+ *
+ * 距离超过 radius 的顶点不会入队, 队列空时停止; 结果缓冲区属于上下文, 只在变大时重新分配,
+ * 因此一次查询的开销只与半径内的顶点数 (及其出边) 有关, 与 V 无关。
+ * 结果在下一次查询之前有效, 调用者不需要释放; dijkstraGetDist 对半径外的顶点返回 DIJKSTRA_INF。
+ *
+ * @param ctx 查询上下文
+ * @param source 起点
+ * @param radius 距离上限 (>= 0)
+ * @param reached 输出: 指向结果数组 (按距离升序, 第一项是起点)
+ * @return 结果个数, 起点无效或内存不足时返回 -1
+ */
+int dijkstraWithinRadius(DijkstraContext* ctx, int source, long long radius, const DijkstraReached** reached);
+
+/**
+ * @brief 双向 Dijkstra 的查询上下文
+ *
+ * 由两个普通查询上下文组成: 前向在 g 上, 后向在 g->reverse 上, 使用同一种优先队列。
+ */
+typedef struct BidirectionalContext {
+    DijkstraContext* forward;
+    DijkstraContext* backward;
+    int meetVertex;   // 最近一次查询中最短路经过的相遇顶点 (不可达时为 0)
+    int numSettled;   // 最近一次查询两个方向确定的顶点总数
+} BidirectionalContext;
+
+/**
+ * @brief 创建双向查询上下文
+ * @param g 图, 必须已构建反向图 (graphBuildReverse)
+ * @param kind 优先队列种类
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+BidirectionalContext* createBidirectionalContext(const Graph* g, PriorityQueueKind kind);
+
+/**
+ * @brief 销毁双向查询上下文
+ */
+void bidirectionalContextDestroy(BidirectionalContext* bc);
+
+/**
+ * @brief 双向 Dijkstra 点对点查询
+ *
+ * 前向与后向搜索交替进行, 当已知最短路上界 μ <= top_f + top_b 时停止。
+ * @param bc 双向查询上下文
+ * @param source 起点
+ * @param target 终点
+ * @return 最短距离 (不可达时为 DIJKSTRA_INF), 顶点无效时返回 -1
+ */
+long long dijkstraBidirectional(BidirectionalContext* bc, int source, int target);
+
+/**
+ * @brief 开始一次新查询: epoch++ (回绕时整体清零一次), 记录起点
+ *
+ * 供 DijkstraKernel.h 生成的内核使用。
+ */
+void dijkstraBeginQuery(DijkstraContext* ctx, int source);
+
+/**
+ * @brief 开始一次目标集合查询: 检查顶点, 开始查询, 并把不同的终点标记为 targetStamp == epoch
+ *
+ * 供 DIJKSTRA_DEFINE_TARGET_SET_KERNEL 生成的内核使用, 返回值即内核的 remaining 参数。
+ * @return 不同终点的个数, 顶点无效或内存不足时返回 -1
+ */
+int dijkstraBeginTargetSet(DijkstraContext* ctx, int source, const int* targets, int numTargets);
+
+/**
+ * @brief 把有界查询的结果缓冲区扩大到至少 capacity 项 (按倍数增长, 已有内容保留)
+ *
+ * 供 DijkstraKernel.h 生成的内核使用。
+ * @return 0 成功, -1 内存不足
+ */
+int dijkstraReserveReached(DijkstraContext* ctx, int capacity);
+
+/**
+ * @brief 读取最近一次查询中 startNode 到 v 的最短距离
+ * @return 距离, 不可达时为 DIJKSTRA_INF
+ */
+static inline long long dijkstraGetDist(const DijkstraContext* ctx, int v) {
+    const DijkstraVertexState* s = &ctx->state[v];
+    return s->stamp == ctx->epoch ? s->dist : DIJKSTRA_INF;
+}
+
+#endif // DIJKSTRA_H
@@ -0,0 +1,597 @@
+#ifndef DIJKSTRA_KERNEL_H
+#define DIJKSTRA_KERNEL_H
+
+#include "Dijkstra.h"
+
+// ===================== 各优先队列的适配函数 =====================
+// 供下面的内核宏使用; 包含本头文件的每个编译单元各自内联一份。
+
+// --- 斐波那契堆适配: 节点指针保存在顶点状态中 ---
+
+static inline void fibPqReset(FibHeap* pq) {
+    fibHeapReset(pq);
+}
+
+static inline void fibPqPush(FibHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    state[v].node = fibHeapInsert(pq, key, v);
+}
+
+static inline void fibPqDecrease(FibHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    if (state[v].node != NULL) {
+        // 节点 v 已在堆中, 执行 decreaseKey
+        fibHeapDecreaseKey(pq, state[v].node, key);
+    } else {
+        state[v].node = fibHeapInsert(pq, key, v);
+    }
+}
+
+static inline int fibPqPop(FibHeap* pq, DijkstraVertexState* state) {
+    int u = fibHeapExtractMin(pq);
+    state[u].node = NULL; // (关键!) 标记为已提取, 防止在 decreaseKey 中误用
+    return u;
+}
+
+// --- 二叉堆适配: 顶点ID即句柄 ---
+
+static inline void binPqPush(BinaryHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    binaryHeapInsert(pq, key, v);
+}
+
+static inline void binPqDecrease(BinaryHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    if (binaryHeapContains(pq, v)) {
+        binaryHeapDecreaseKey(pq, v, key);
+    } else {
+        binaryHeapInsert(pq, key, v);
+    }
+}
+
+static inline int binPqPop(BinaryHeap* pq, DijkstraVertexState* state) {
+    (void)state;
+    return binaryHeapExtractMin(pq);
+}
+
+// --- 基数堆适配: 顶点ID即句柄, 键单调不减 ---
+
+static inline void radixPqPush(RadixHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    radixHeapInsert(pq, key, v);
+}
+
+static inline void radixPqDecrease(RadixHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    if (radixHeapContains(pq, v)) {
+        radixHeapDecreaseKey(pq, v, key);
+    } else {
+        radixHeapInsert(pq, key, v);
+    }
+}
+
+static inline int radixPqPop(RadixHeap* pq, DijkstraVertexState* state) {
+    (void)state;
+    return radixHeapExtractMin(pq);
+}
+
+// --- 配对堆适配: 节点数组以顶点ID为下标 ---
+
+static inline void pairingPqPush(PairingHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    pairingHeapInsert(pq, key, v);
+}
+
+static inline void pairingPqDecrease(PairingHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    if (pairingHeapContains(pq, v)) {
+        pairingHeapDecreaseKey(pq, v, key);
+    } else {
+        pairingHeapInsert(pq, key, v);
+    }
+}
+
+static inline int pairingPqPop(PairingHeap* pq, DijkstraVertexState* state) {
+    (void)state;
+    return pairingHeapExtractMin(pq);
+}
+
+// --- d 叉堆适配: 顶点ID即句柄 ---
+
+static inline void daryPqPush(DaryHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    daryHeapInsert(pq, key, v);
+}
+
+static inline void daryPqDecrease(DaryHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    if (daryHeapContains(pq, v)) {
+        daryHeapDecreaseKey(pq, v, key);
+    } else {
+        daryHeapInsert(pq, key, v);
+    }
+}
+
+static inline int daryPqPop(DaryHeap* pq, DijkstraVertexState* state) {
+    (void)state;
+    return daryHeapExtractMin(pq);
+}
+
+// --- 下标斐波那契堆适配: 顶点ID即句柄, 不需要 state[v].node ---
+
+static inline void indexedFibPqPush(IndexedFibHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    indexedFibHeapInsert(pq, key, v);
+}
+
+static inline void indexedFibPqDecrease(IndexedFibHeap* pq, DijkstraVertexState* state, int v, long long key) {
+    (void)state;
+    if (indexedFibHeapContains(pq, v)) {
+        indexedFibHeapDecreaseKey(pq, v, key);
+    } else {
+        indexedFibHeapInsert(pq, key, v);
+    }
+}
+
+static inline int indexedFibPqPop(IndexedFibHeap* pq, DijkstraVertexState* state) {
+    (void)state;
+    return indexedFibHeapExtractMin(pq);
+}
+
+// ===================== 队列列表 =====================
+
+/**
+ * @brief 所有优先队列及其适配函数的列表 (X-macro), 顺序与 PriorityQueueKind 相同
+ *
+ *     X(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY, RESET, PUSH, DECREASE, POP, EMPTY, MINKEY)
+ *
+ * CREATE(capacity) / DESTROY(pq) 创建和销毁队列, 其余参数与下面的内核模板相同。
+ * 各内核族的特化实例 (名称为 前缀##SUFFIX) 和按 ctx->kind 的分派都由这张表生成,
+ * 新增一种队列只需在 PriorityQueue.h 中加入枚举值和名称, 并在这里加一行。
+ */
+#define DIJKSTRA_QUEUE_LIST(X)                                                                         \
+    X(PQ_FIBONACCI, Fib, FibHeap, createFibHeapWithCapacity, fibHeapDestroy,                           \
+      fibPqReset, fibPqPush, fibPqDecrease, fibPqPop, fibHeapIsEmpty, fibHeapMinKey)                   \
+    X(PQ_BINARY, Binary, BinaryHeap, createBinaryHeap, binaryHeapDestroy,                              \
+      binaryHeapReset, binPqPush, binPqDecrease, binPqPop, binaryHeapIsEmpty, binaryHeapMinKey)        \
+    X(PQ_RADIX, Radix, RadixHeap, createRadixHeap, radixHeapDestroy,                                   \
+      radixHeapReset, radixPqPush, radixPqDecrease, radixPqPop, radixHeapIsEmpty, radixHeapMinKey)     \
+    X(PQ_PAIRING, Pairing, PairingHeap, createPairingHeap, pairingHeapDestroy,                         \
+      pairingHeapReset, pairingPqPush, pairingPqDecrease, pairingPqPop, pairingHeapIsEmpty,            \
+      pairingHeapMinKey)                                                                               \
+    X(PQ_DARY, Dary, DaryHeap, createDaryHeap, daryHeapDestroy,                                        \
+      daryHeapReset, daryPqPush, daryPqDecrease, daryPqPop, daryHeapIsEmpty, daryHeapMinKey)           \
+    X(PQ_FIB_INDEXED, IndexedFib, IndexedFibHeap, createIndexedFibHeap, indexedFibHeapDestroy,         \
+      indexedFibHeapReset, indexedFibPqPush, indexedFibPqDecrease, indexedFibPqPop,                    \
+      indexedFibHeapIsEmpty, indexedFibHeapMinKey)
+
+// ===================== 内核模板 =====================
+
+/**
+ * @brief 生成一个针对具体优先队列静态特化的 Dijkstra 内核
+ *
+ *     static int NAME(DijkstraContext* ctx, QUEUE_T* pq, int source, int target)
+ *
+ * 队列通过以下适配函数 (或宏) 接入, 均以顶点ID为句柄, 在同一编译单元内完全内联,
+ * 没有函数指针开销:
+ *   RESET(pq)                    清空队列
+ *   PUSH(pq, state, v, key)      v 在本次查询中首次被发现
+ *   DECREASE(pq, state, v, key)  v 的距离变小 (v 是否仍在队列中由适配层判断)
+ *   POP(pq, state)               弹出并返回距离最小的顶点
+ *   EMPTY(pq)                    队列是否为空
+ *
+ * target > 0 时, 在 target 出队 (距离确定) 后立即停止; 否则计算一对多距离。
+ * 返回确定 (出队) 的顶点数; 结果用 dijkstraGetDist 读取。
+ */
+#define DIJKSTRA_DEFINE_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY)    \
+static int NAME(DijkstraContext* ctx, QUEUE_T* pq, int source, int target) {      \
+    const Graph* g = ctx->g;                                                      \
+    dijkstraBeginQuery(ctx, source);                                              \
+    const unsigned int epoch = ctx->epoch;                                        \
+    DijkstraVertexState* state = ctx->state;                                      \
+    RESET(pq);                                                                    \
+                                                                                  \
+    state[source].stamp = epoch;                                                  \
+    state[source].dist = 0;                                                       \
+    state[source].node = NULL;                                                    \
+    PUSH(pq, state, source, 0);                                                   \
+                                                                                  \
+    int settled = 0;                                                              \
+    while (!EMPTY(pq)) {                                                          \
+        int u = POP(pq, state);                                                   \
+        settled++;                                                                \
+        if (u == target) break;                                                   \
+        long long du = state[u].dist;                                             \
+        int edgeEnd = g->offsets[u + 1];                                          \
+        for (int e = g->offsets[u]; e < edgeEnd; ++e) {                           \
+            int v = g->targets[e];                                                \
+            long long newDist = du + g->weights[e];                               \
+            DijkstraVertexState* sv = &state[v];                                  \
+            if (sv->stamp != epoch) {                                             \
+                sv->stamp = epoch;                                                \
+                sv->dist = newDist;                                               \
+                sv->node = NULL;                                                  \
+                PUSH(pq, state, v, newDist);                                      \
+            } else if (newDist < sv->dist) {                                      \
+                sv->dist = newDist;                                               \
+                DECREASE(pq, state, v, newDist);                                  \
+            }                                                                     \
+        }                                                                         \
+    }                                                                             \
+    ctx->numSettled = settled;                                                    \
+    return settled;                                                               \
+}
+
+/**
+ * @brief 生成目标集合内核: 与 DIJKSTRA_DEFINE_KERNEL 相同, 但有两个停止条件
+ *
+ *     static int NAME(DijkstraContext* ctx, QUEUE_T* pq, int source, int remaining, long long maxDist)
+ *
+ * 调用者已调用 dijkstraBeginQuery, 并把 remaining 个不同的终点标记为 ctx->targetStamp[t] == epoch。
+ * 每个终点出队时 remaining 减一, 减到 0 时停止; 出队顶点的距离超过 maxDist 时也停止
+ * (之后出队的顶点只会更远)。返回确定 (出队) 的顶点数。
+ */
+#define DIJKSTRA_DEFINE_TARGET_SET_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY) \
+static int NAME(DijkstraContext* ctx, QUEUE_T* pq, int source, int remaining, long long maxDist) { \
+    const Graph* g = ctx->g;                                                      \
+    const unsigned int epoch = ctx->epoch;                                        \
+    DijkstraVertexState* state = ctx->state;                                      \
+    const unsigned int* targetStamp = ctx->targetStamp;                           \
+    RESET(pq);                                                                    \
+                                                                                  \
+    state[source].stamp = epoch;                                                  \
+    state[source].dist = 0;                                                       \
+    state[source].node = NULL;                                                    \
+    PUSH(pq, state, source, 0);                                                   \
+                                                                                  \
+    int settled = 0;                                                              \
+    while (remaining > 0 && !EMPTY(pq)) {                                         \
+        int u = POP(pq, state);                                                   \
+        settled++;                                                                \
+        long long du = state[u].dist;                                             \
+        if (du > maxDist) break;                                                  \
+        if (targetStamp[u] == epoch && --remaining == 0) break;                   \
+        int edgeEnd = g->offsets[u + 1];                                          \
+        for (int e = g->offsets[u]; e < edgeEnd; ++e) {                           \
+            int v = g->targets[e];                                                \
+            long long newDist = du + g->weights[e];                               \
+            DijkstraVertexState* sv = &state[v];                                  \
+            if (sv->stamp != epoch) {                                             \
+                sv->stamp = epoch;                                                \
+                sv->dist = newDist;                                               \
+                sv->node = NULL;                                                  \
+                PUSH(pq, state, v, newDist);                                      \
+            } else if (newDist < sv->dist) {                                      \
+                sv->dist = newDist;                                               \
+                DECREASE(pq, state, v, newDist);                                  \
+            }                                                                     \
+        }                                                                         \
+    }                                                                             \
+    ctx->numSettled = settled;                                                    \
+    return settled;                                                               \
+}
+
+/**
+ * @brief 生成有界 (等时圈) 内核
+ *
+ *     static int NAME(DijkstraContext* ctx, QUEUE_T* pq, int source, long long radius)
+ *
+ * 与 DIJKSTRA_DEFINE_KERNEL 相同, 但距离超过 radius 的顶点不入队 (也不打时间戳),
+ * 出队的顶点依次追加到 ctx->reached。返回确定的顶点数, 缓冲区扩容失败时返回 -1。
+ */
+#define DIJKSTRA_DEFINE_RADIUS_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY) \
+static int NAME(DijkstraContext* ctx, QUEUE_T* pq, int source, long long radius) { \
+    const Graph* g = ctx->g;                                                      \
+    dijkstraBeginQuery(ctx, source);                                              \
+    const unsigned int epoch = ctx->epoch;                                        \
+    DijkstraVertexState* state = ctx->state;                                      \
+    RESET(pq);                                                                    \
+                                                                                  \
+    state[source].stamp = epoch;                                                  \
+    state[source].dist = 0;                                                       \
+    state[source].node = NULL;                                                    \
+    PUSH(pq, state, source, 0);                                                   \
+                                                                                  \
+    int settled = 0;                                                              \
+    while (!EMPTY(pq)) {                                                          \
+        int u = POP(pq, state);                                                   \
+        long long du = state[u].dist;                                             \
+        if (settled == ctx->reachedCapacity &&                                    \
+            dijkstraReserveReached(ctx, settled + 1) != 0) {                      \
+            ctx->numSettled = settled;                                            \
+            return -1;                                                            \
+        }                                                                         \
+        ctx->reached[settled].vertex = u;                                         \
+        ctx->reached[settled].dist = du;                                          \
+        settled++;                                                                \
+        int edgeEnd = g->offsets[u + 1];                                          \
+        for (int e = g->offsets[u]; e < edgeEnd; ++e) {                           \
+            int v = g->targets[e];                                                \
+            long long newDist = du + g->weights[e];                               \
+            if (newDist > radius) continue;                                       \
+            DijkstraVertexState* sv = &state[v];                                  \
+            if (sv->stamp != epoch) {                                             \
+                sv->stamp = epoch;                                                \
+                sv->dist = newDist;                                               \
+                sv->node = NULL;                                                  \
+                PUSH(pq, state, v, newDist);                                      \
+            } else if (newDist < sv->dist) {                                      \
+                sv->dist = newDist;                                               \
+                DECREASE(pq, state, v, newDist);                                  \
+            }                                                                     \
+        }                                                                         \
+    }                                                                             \
+    ctx->numSettled = settled;                                                    \
+    return settled;                                                               \
+}
+
+/**
+ * @brief 生成压缩邻接内核 (一对多)
+ *
+ *     static int NAME(DijkstraContext* ctx, const CompressedGraph* cg, QUEUE_T* pq, int source)
+ *
+ * 与 DIJKSTRA_DEFINE_KERNEL 相同, 但出边由 compressedEdgesNext 从字节流中解码;
+ * 使用处须包含 CompressedGraph.h。返回确定 (出队) 的顶点数。
+ */
+#define DIJKSTRA_DEFINE_COMPRESSED_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY) \
+static int NAME(DijkstraContext* ctx, const CompressedGraph* cg, QUEUE_T* pq, int source) { \
+    dijkstraBeginQuery(ctx, source);                                              \
+    const unsigned int epoch = ctx->epoch;                                        \
+    DijkstraVertexState* state = ctx->state;                                      \
+    RESET(pq);                                                                    \
+                                                                                  \
+    state[source].stamp = epoch;                                                  \
+    state[source].dist = 0;                                                       \
+    state[source].node = NULL;                                                    \
+    PUSH(pq, state, source, 0);                                                   \
+                                                                                  \
+    int settled = 0;                                                              \
+    while (!EMPTY(pq)) {                                                          \
+        int u = POP(pq, state);                                                   \
+        settled++;                                                                \
+        long long du = state[u].dist;                                             \
+        CompressedEdgeIter it;                                                    \
+        compressedEdgesBegin(cg, u, &it);                                         \
+        int v, w;                                                                 \
+        while (compressedEdgesNext(&it, &v, &w)) {                                \
+            long long newDist = du + w;                                           \
+            DijkstraVertexState* sv = &state[v];                                  \
+            if (sv->stamp != epoch) {                                             \
+                sv->stamp = epoch;                                                \
+                sv->dist = newDist;                                               \
+                sv->node = NULL;                                                  \
+                PUSH(pq, state, v, newDist);                                      \
+            } else if (newDist < sv->dist) {                                      \
+                sv->dist = newDist;                                               \
+                DECREASE(pq, state, v, newDist);                                  \
+            }                                                                     \
+        }                                                                         \
+    }                                                                             \
+    ctx->numSettled = settled;                                                    \
+    return settled;                                                               \
+}
+
+/**
+ * @brief 生成双向 Dijkstra 内核 (点对点)
+ *
+ *     static long long NAME(BidirectionalContext* bc, int source, int target)
+ *
+ * 前向搜索在 g 上从 source 出发, 后向搜索在 g->reverse 上从 target 出发,
+ * 两个方向交替各确定一个顶点。松弛边 (x, y) 时若 y 已被另一方向触及,
+ * 用 d_this(y) + d_other(y) 更新最短路上界 μ; 当 μ <= top_f + top_b
+ * (两个队列的最小键之和) 时停止, 此时 μ 就是最短距离。
+ * 除上述适配函数外还需要 MINKEY(pq): 查看最小键, 空队列返回 LLONG_MAX。
+ * 返回最短距离, 不可达时为 DIJKSTRA_INF。
+ */
+#define DIJKSTRA_DEFINE_BIDIRECTIONAL_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY, MINKEY) \
+static long long NAME(BidirectionalContext* bc, int source, int target) {         \
+    DijkstraContext* side[2] = { bc->forward, bc->backward };                     \
+    QUEUE_T* pq[2];                                                               \
+    int endpoint[2] = { source, target };                                         \
+    for (int d = 0; d < 2; ++d) {                                                 \
+        DijkstraContext* c = side[d];                                             \
+        pq[d] = (QUEUE_T*)c->pq;                                                  \
+        dijkstraBeginQuery(c, endpoint[d]);                                       \
+        RESET(pq[d]);                                                             \
+        DijkstraVertexState* s = &c->state[endpoint[d]];                          \
+        s->stamp = c->epoch;                                                      \
+        s->dist = 0;                                                              \
+        s->node = NULL;                                                           \
+        PUSH(pq[d], c->state, endpoint[d], 0);                                    \
+    }                                                                             \
+                                                                                  \
+    long long mu = (source == target) ? 0 : DIJKSTRA_INF;                         \
+    int meet = (source == target) ? source : 0;                                   \
+    int dir = 0;                                                                  \
+    while (!EMPTY(pq[0]) && !EMPTY(pq[1])) {                                      \
+        long long topF = MINKEY(pq[0]);                                           \
+        long long topB = MINKEY(pq[1]);                                           \
+        if (mu != DIJKSTRA_INF && mu <= topF + topB) break;                       \
+                                                                                  \
+        DijkstraContext* c = side[dir];                                           \
+        DijkstraContext* other = side[1 - dir];                                   \
+        const Graph* g = c->g;                                                    \
+        const unsigned int epoch = c->epoch;                                      \
+        const unsigned int otherEpoch = other->epoch;                             \
+        DijkstraVertexState* state = c->state;                                    \
+        int u = POP(pq[dir], state);                                              \
+        c->numSettled++;                                                          \
+        long long du = state[u].dist;                                             \
+        int edgeEnd = g->offsets[u + 1];                                          \
+        for (int e = g->offsets[u]; e < edgeEnd; ++e) {                           \
+            int v = g->targets[e];                                                \
+            long long newDist = du + g->weights[e];                               \
+            DijkstraVertexState* sv = &state[v];                                  \
+            if (sv->stamp != epoch) {                                             \
+                sv->stamp = epoch;                                                \
+                sv->dist = newDist;                                               \
+                sv->node = NULL;                                                  \
+                PUSH(pq[dir], state, v, newDist);                                 \
+            } else if (newDist < sv->dist) {                                      \
+                sv->dist = newDist;                                               \
+                DECREASE(pq[dir], state, v, newDist);                             \
+            } else {                                                              \
+                continue;                                                         \
+            }                                                                     \
+            const DijkstraVertexState* ov = &other->state[v];                     \
+            if (ov->stamp == otherEpoch && newDist + ov->dist < mu) {             \
+                mu = newDist + ov->dist;                                          \
+                meet = v;                                                         \
+            }                                                                     \
+        }                                                                         \
+        dir = 1 - dir;                                                            \
+    }                                                                             \
+    bc->meetVertex = meet;                                                        \
+    bc->numSettled = bc->forward->numSettled + bc->backward->numSettled;          \
+    return mu;                                                                    \
+}
+
+/**
+ * @brief 生成目标导向 (A*) 点对点内核
+ *
+ *     static int NAME(DijkstraContext* ctx, QUEUE_T* pq, HCTX_T* hc, long long* hcache,
+ *                     int source, int target)
+ *
+ * 与 DIJKSTRA_DEFINE_KERNEL 相同, 但队列键为 dist + h(v), 其中 HEUR(hc, v) 是 v 到 target
+ * 的下界, 必须一致 (h(u) <= w(u,v) + h(v)): 这样顶点出队时距离已确定, 键也单调不减
+ * (基数堆可用)。h(v) 在本次查询首次触及 v 时计算一次, 缓存在 hcache[v] 中。
+ * target 出队即停止; 返回确定的顶点数, target 的距离用 dijkstraGetDist 读取。
+ */
+#define DIJKSTRA_DEFINE_ASTAR_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY, HCTX_T, HEUR) \
+static int NAME(DijkstraContext* ctx, QUEUE_T* pq, HCTX_T* hc, long long* hcache,  \
+                int source, int target) {                                         \
+    const Graph* g = ctx->g;                                                      \
+    dijkstraBeginQuery(ctx, source);                                              \
+    const unsigned int epoch = ctx->epoch;                                        \
+    DijkstraVertexState* state = ctx->state;                                      \
+    RESET(pq);                                                                    \
+                                                                                  \
+    state[source].stamp = epoch;                                                  \
+    state[source].dist = 0;                                                       \
+    state[source].node = NULL;                                                    \
+    hcache[source] = HEUR(hc, source);                                            \
+    PUSH(pq, state, source, hcache[source]);                                      \
+                                                                                  \
+    int settled = 0;                                                              \
+    while (!EMPTY(pq)) {                                                          \
+        int u = POP(pq, state);                                                   \
+        settled++;                                                                \
+        if (u == target) break;                                                   \
+        long long du = state[u].dist;                                             \
+        int edgeEnd = g->offsets[u + 1];                                          \
+        for (int e = g->offsets[u]; e < edgeEnd; ++e) {                           \
+            int v = g->targets[e];                                                \
+            long long newDist = du + g->weights[e];                               \
+            DijkstraVertexState* sv = &state[v];                                  \
+            if (sv->stamp != epoch) {                                             \
+                sv->stamp = epoch;                                                \
+                sv->dist = newDist;                                               \
+                sv->node = NULL;                                                  \
+                hcache[v] = HEUR(hc, v);                                          \
+                PUSH(pq, state, v, newDist + hcache[v]);                          \
+            } else if (newDist < sv->dist) {                                      \
+                sv->dist = newDist;                                               \
+                DECREASE(pq, state, v, newDist + hcache[v]);                      \
+            }                                                                     \
+        }                                                                         \
+    }                                                                             \
+    ctx->numSettled = settled;                                                    \
+    return settled;                                                               \
+}
+
+/**
+ * @brief 生成收缩层次 (CH) 的双向向上搜索内核
+ *
+ *     static long long NAME(CTX_T* qc, int source, int target)
+ *
+ * CTX_T 需要有 forward / backward (DijkstraContext*), stallOnDemand, meetVertex, numSettled 字段。
+ * 前向在 forward->g (upward) 上、后向在 backward->g (downward) 上搜索, 两个方向交替进行;
+ * 与普通双向搜索不同, 每个方向各自搜到堆顶 >= μ 才停止 (最短路的最高点可能远离两端)。
+ * stall-on-demand: 若顶点 u 能经由另一张图中指向 u 的更高层顶点 x 更短地到达
+ * (d(x) + w(x,u) < d(u)), 则 d(u) 不是最短距离, 不展开 u 的出边。
+ * 返回最短距离, 不可达时为 DIJKSTRA_INF。
+ */
+#define DIJKSTRA_DEFINE_CH_KERNEL(NAME, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY, MINKEY, CTX_T) \
+static long long NAME(CTX_T* qc, int source, int target) {                        \
+    DijkstraContext* side[2] = { qc->forward, qc->backward };                     \
+    QUEUE_T* pq[2];                                                               \
+    int endpoint[2] = { source, target };                                         \
+    for (int d = 0; d < 2; ++d) {                                                 \
+        DijkstraContext* c = side[d];                                             \
+        pq[d] = (QUEUE_T*)c->pq;                                                  \
+        dijkstraBeginQuery(c, endpoint[d]);                                       \
+        RESET(pq[d]);                                                             \
+        DijkstraVertexState* s = &c->state[endpoint[d]];                          \
+        s->stamp = c->epoch;                                                      \
+        s->dist = 0;                                                              \
+        s->node = NULL;                                                           \
+        PUSH(pq[d], c->state, endpoint[d], 0);                                    \
+    }                                                                             \
+                                                                                  \
+    long long mu = (source == target) ? 0 : DIJKSTRA_INF;                         \
+    int meet = (source == target) ? source : 0;                                   \
+    int active[2] = { 1, 1 };                                                     \
+    int dir = 0;                                                                  \
+    while (active[0] || active[1]) {                                              \
+        if (!active[dir]) dir = 1 - dir;                                          \
+        if (EMPTY(pq[dir]) || MINKEY(pq[dir]) >= mu) {                            \
+            active[dir] = 0;                                                      \
+            continue;                                                             \
+        }                                                                         \
+                                                                                  \
+        DijkstraContext* c = side[dir];                                           \
+        DijkstraContext* other = side[1 - dir];                                   \
+        const Graph* g = c->g;                                                    \
+        const unsigned int epoch = c->epoch;                                      \
+        const unsigned int otherEpoch = other->epoch;                             \
+        DijkstraVertexState* state = c->state;                                    \
+        int u = POP(pq[dir], state);                                              \
+        c->numSettled++;                                                          \
+        long long du = state[u].dist;                                             \
+        const DijkstraVertexState* ou = &other->state[u];                         \
+        if (ou->stamp == otherEpoch && du + ou->dist < mu) {                      \
+            mu = du + ou->dist;                                                   \
+            meet = u;                                                             \
+        }                                                                         \
+                                                                                  \
+        int stalled = 0;                                                          \
+        if (qc->stallOnDemand) {                                                  \
+            const Graph* sg = other->g;                                           \
+            for (int e = sg->offsets[u]; e < sg->offsets[u + 1]; ++e) {           \
+                const DijkstraVertexState* sx = &state[sg->targets[e]];           \
+                if (sx->stamp == epoch && sx->dist + sg->weights[e] < du) {       \
+                    stalled = 1;                                                  \
+                    break;                                                        \
+                }                                                                 \
+            }                                                                     \
+        }                                                                         \
+        if (!stalled) {                                                           \
+            int edgeEnd = g->offsets[u + 1];                                      \
+            for (int e = g->offsets[u]; e < edgeEnd; ++e) {                       \
+                int v = g->targets[e];                                            \
+                long long newDist = du + g->weights[e];                           \
+                DijkstraVertexState* sv = &state[v];                              \
+                if (sv->stamp != epoch) {                                         \
+                    sv->stamp = epoch;                                            \
+                    sv->dist = newDist;                                           \
+                    sv->node = NULL;                                              \
+                    PUSH(pq[dir], state, v, newDist);                             \
+                } else if (newDist < sv->dist) {                                  \
+                    sv->dist = newDist;                                           \
+                    DECREASE(pq[dir], state, v, newDist);                         \
+                } else {                                                          \
+                    continue;                                                     \
+                }                                                                 \
+                const DijkstraVertexState* ov = &other->state[v];                 \
+                if (ov->stamp == otherEpoch && newDist + ov->dist < mu) {         \
+                    mu = newDist + ov->dist;                                      \
+                    meet = v;                                                     \
+                }                                                                 \
+            }                                                                     \
+        }                                                                         \
+        dir = 1 - dir;                                                            \
+    }                                                                             \
+    qc->meetVertex = meet;                                                        \
+    qc->numSettled = qc->forward->numSettled + qc->backward->numSettled;          \
+    return mu;                                                                    \
+}
+
+#endif // DIJKSTRA_KERNEL_H
@@ -5,12 +5,24 @@ static void _fibHeapConsolidate(FibHeap* H);
 static void _fibHeapLink(FibHeap* H, FibHeapNode* y, FibHeapNode* x);
 static void _fibHeapCut(FibHeap* H, FibHeapNode* x, FibHeapNode* y);
 static void _fibHeapCascadingCut(FibHeap* H, FibHeapNode* y);
-static void _fibHeapRecursiveDestroy(FibHeapNode* node);
+static int _fibHeapAddSlab(FibHeap* H, int size);
+
+// 未给出容量提示时, 第一个节点块的大小
+#define FIB_HEAP_MIN_SLAB 1024
+// 自动增长时单个节点块的最大节点数
+#define FIB_HEAP_MAX_SLAB (1 << 24)
 
 /**
  * @brief 创建堆
  */
 FibHeap* createFibHeap() {
+    return createFibHeapWithCapacity(0);
+}
+
+/**
+ * @brief 创建堆并预分配节点池
+ */
+FibHeap* createFibHeapWithCapacity(int capacityHint) {
     FibHeap* H = (FibHeap*)malloc(sizeof(FibHeap));
     if (H == NULL) {
         perror("错误: 无法为堆分配内存");
@@ -18,9 +30,62 @@ FibHeap* createFibHeap() {
     }
     H->minNode = NULL;
     H->numNodes = 0;
+    H->slabs = NULL;
+    H->slabSizes = NULL;
+    H->numSlabs = 0;
+    H->slabArrayCap = 0;
+    H->currentSlab = 0;
+    H->slabUsed = 0;
+    H->freeList = NULL;
+    H->degreeTable = NULL;
+    H->degreeTableCap = 0;
+
+    if (capacityHint > 0 && _fibHeapAddSlab(H, capacityHint) != 0) {
+        fibHeapDestroy(H);
+        return NULL;
+    }
     return H;
 }
 
+/**
+ * @brief 向节点池追加一个含 size 个节点的块
+ */
+static int _fibHeapAddSlab(FibHeap* H, int size) {
+    if (H->numSlabs == H->slabArrayCap) {
+        int cap = H->slabArrayCap > 0 ? H->slabArrayCap * 2 : 8;
+        FibHeapNode** slabs = (FibHeapNode**)realloc(H->slabs, cap * sizeof(FibHeapNode*));
+        if (slabs != NULL) H->slabs = slabs;
+        int* sizes = (int*)realloc(H->slabSizes, cap * sizeof(int));
+        if (sizes != NULL) H->slabSizes = sizes;
+        if (slabs == NULL || sizes == NULL) {
+            perror("错误: 无法扩展节点池");
+            return -1;
+        }
+        H->slabArrayCap = cap;
+    }
+
+    FibHeapNode* slab = (FibHeapNode*)malloc((size_t)size * sizeof(FibHeapNode));
+    if (slab == NULL) {
+        perror("错误: 无法为节点块分配内存");
+        return -1;
+    }
+    H->slabs[H->numSlabs] = slab;
+    H->slabSizes[H->numSlabs] = size;
+    H->numSlabs++;
+    return 0;
+}
+
+/**
+ * @brief 清空堆 (O(1))
+ */
+void fibHeapReset(FibHeap* H) {
+    H->minNode = NULL;
+    H->numNodes = 0;
+    H->currentSlab = 0;
+    H->slabUsed = 0;
+    H->freeList = NULL;
+}
+
 /**
  * @brief 检查堆是否为空
  */
@@ -29,13 +94,37 @@ int fibHeapIsEmpty(const FibHeap* H) {
 }
 
 /**
- * @brief 创建一个新节点
+ * @brief 查看最小键
  */
-static FibHeapNode* _createNode(long long key, int value) {
-    FibHeapNode* node = (FibHeapNode*)malloc(sizeof(FibHeapNode));
-    if (node == NULL) {
-        perror("错误: 无法为堆节点分配内存");
-        return NULL;
+long long fibHeapMinKey(const FibHeap* H) {
+    return H->minNode != NULL ? H->minNode->key : LLONG_MAX;
+}
+
+/**
+ * @brief 从节点池取出一个新节点
+ *
+ * 顺序: 空闲链表 → 当前块剩余空间 → 下一个已有块 → 新块 (容量翻倍)
+ */
+static FibHeapNode* _createNode(FibHeap* H, long long key, int value) {
+    FibHeapNode* node;
+    if (H->freeList != NULL) {
+        node = H->freeList;
+        H->freeList = node->right;
+    } else {
+        while (H->currentSlab < H->numSlabs &&
+               H->slabUsed == H->slabSizes[H->currentSlab]) {
+            H->currentSlab++;
+            H->slabUsed = 0;
+        }
+        if (H->currentSlab == H->numSlabs) {
+            // 新块大小等于已有总容量 (总容量翻倍), 上限 FIB_HEAP_MAX_SLAB
+            long long size = FIB_HEAP_MIN_SLAB;
+            for (int i = 0; i < H->numSlabs; ++i) size += H->slabSizes[i];
+            if (size > FIB_HEAP_MAX_SLAB) size = FIB_HEAP_MAX_SLAB;
+            if (_fibHeapAddSlab(H, (int)size) != 0) return NULL;
+            H->slabUsed = 0;
+        }
+        node = &H->slabs[H->currentSlab][H->slabUsed++];
     }
     node->key = key;
     node->value = value;
@@ -70,7 +159,7 @@ static void _fibHeapAddNodeToRootList(FibHeap* H, FibHeapNode* x) {
  * @brief 插入新节点
  */
 FibHeapNode* fibHeapInsert(FibHeap* H, long long key, int value) {
-    FibHeapNode* node = _createNode(key, value);
+    FibHeapNode* node = _createNode(H, key, value);
     if (node == NULL) return NULL; // 内存分配失败
 
     _fibHeapAddNodeToRootList(H, node);
@@ -120,33 +209,67 @@ int fibHeapExtractMin(FibHeap* H) {
     }
 
     H->numNodes--;
-    free(z); // 释放内存
+    z->right = H->freeList; // 节点归还到空闲链表
+    H->freeList = z;
     return minValue;
 }
 
+/**
+ * @brief 度数上界 D(n) (纯整数运算)
+ *
+ * D(n) <= log_phi(n) ≈ 1.4404 * log2(n)。取 bits = n 的二进制位数 (> log2 n),
+ * 用 bits + bits/2 (>= 1.5 * log2 n) 作为上界, 再 +2 作为安全裕度。
+ */
+static int _fibHeapDegreeBound(int n) {
+    unsigned int x = (unsigned int)(n > 0 ? n : 1);
+#if defined(__GNUC__)
+    int bits = 32 - __builtin_clz(x);
+#else
+    int bits = 0;
+    while (x != 0) {
+        bits++;
+        x >>= 1;
+    }
+#endif
+    return bits + (bits >> 1) + 2;
+}
+
+/**
+ * @brief 扩大度数表 (新增部分置 NULL), 仅在度数上界超过当前容量时调用
+ */
+static int _fibHeapGrowDegreeTable(FibHeap* H, int needed) {
+    int cap = H->degreeTableCap > 0 ? H->degreeTableCap : 16;
+    while (cap < needed) cap *= 2;
+
+    FibHeapNode** table = (FibHeapNode**)realloc(H->degreeTable, cap * sizeof(FibHeapNode*));
+    if (table == NULL) {
+        perror("错误: 无法为Consolidate度数表分配内存");
+        return -1;
+    }
+    for (int i = H->degreeTableCap; i < cap; ++i) table[i] = NULL;
+    H->degreeTable = table;
+    H->degreeTableCap = cap;
+    return 0;
+}
+
 /**
  * @brief 合并根链表
+ *
+ * 不做任何堆分配: 度数表常驻在堆中, 根链表原地遍历。
+ * 先数出根的个数, 再沿 right 指针逐个处理; 处理 x 之前先记下 x->right,
+ * 因为链接只会把 x 或已处理过的根从根链表中摘除, 记下的下一个根始终有效。
+ * 链接后剩下的根仍在根链表中, 最后只需扫描度数表找出新的最小节点并清空表。
  */
 static void _fibHeapConsolidate(FibHeap* H) {
     if (H->minNode == NULL) return;
 
-    // D(n) = O(log n)
-    // +2 是为了安全裕度
-    int maxDegree = (int)floor(log2(H->numNodes) / log2(1.618)) + 2; 
-    
-    FibHeapNode** A = (FibHeapNode**)calloc(maxDegree, sizeof(FibHeapNode*));
-    if (A == NULL) {
-        perror("错误: 无法为Consolidate数组分配内存");
+    int maxDegree = _fibHeapDegreeBound(H->numNodes);
+    if (maxDegree > H->degreeTableCap && _fibHeapGrowDegreeTable(H, maxDegree) != 0) {
         return;
     }
-    
-    // 遍历根链表
-    FibHeapNode* w = H->minNode;
-    FibHeapNode* stop = w->left;
-    int processed = 0;
-    
-    // 我们需要一个方式来安全遍历, 因为节点会被移除
-    // C++的vector.push_back很方便, C需要手动构建
+    FibHeapNode** A = H->degreeTable;
+
+    // 数出根的个数
     int rootCount = 0;
     FibHeapNode* current = H->minNode;
     do {
@@ -154,22 +277,12 @@ static void _fibHeapConsolidate(FibHeap* H) {
         current = current->right;
     } while (current != H->minNode);
 
-    FibHeapNode** rootList = (FibHeapNode**)malloc(rootCount * sizeof(FibHeapNode*));
-    if (rootList == NULL) {
-        perror("错误: 无法为根列表数组分配内存");
-        free(A);
-        return;
-    }
-    
-    current = H->minNode;
-    for(int i = 0; i < rootCount; i++) {
-        rootList[i] = current;
-        current = current->right;
-    }
-    
-    // 现在遍历这个静态数组
+    // 原地遍历根链表
+    int usedDegree = 0;
+    FibHeapNode* w = H->minNode;
     for (int i = 0; i < rootCount; i++) {
-        FibHeapNode* x = rootList[i];
+        FibHeapNode* x = w;
+        w = w->right;
         int d = x->degree;
         
         while (A[d] != NULL) {
@@ -187,22 +300,19 @@ static void _fibHeapConsolidate(FibHeap* H) {
             d++;
         }
         A[d] = x;
+        if (d > usedDegree) usedDegree = d;
     }
-    
-    free(rootList); // 释放临时数组
 
-    // 重建根链表
+    // 找出新的最小节点, 同时把度数表恢复为全 NULL
     H->minNode = NULL;
-    for (int i = 0; i < maxDegree; ++i) {
+    for (int i = 0; i <= usedDegree; ++i) {
         if (A[i] != NULL) {
-            _fibHeapAddNodeToRootList(H, A[i]);
             if (H->minNode == NULL || A[i]->key < H->minNode->key) {
                 H->minNode = A[i];
             }
+            A[i] = NULL;
         }
     }
-    
-    free(A); // 释放辅助数组
 }
 
 /**
@@ -300,35 +410,18 @@ static void _fibHeapCascadingCut(FibHeap* H, FibHeapNode* y) {
     }
 }
 
-/**
- * @brief 递归销毁节点 (用于 fibHeapDestroy)
- */
-static void _fibHeapRecursiveDestroy(FibHeapNode* node) {
-    if (node == NULL) return;
-    
-    // 安全地遍历循环链表
-    FibHeapNode* current = node;
-    FibHeapNode* start = node;
-    FibHeapNode* next;
-    
-    do {
-        next = current->right;
-        
-        // 递归销毁子树
-        _fibHeapRecursiveDestroy(current->child);
-        
-        // 释放当前节点
-        free(current);
-        
-        current = next;
-    } while (current != start);
-}
-
 /**
  * @brief 销毁堆
+ *
+ * 所有节点都位于节点池的块中, 逐块释放即可, 不需要递归遍历森林。
  */
 void fibHeapDestroy(FibHeap* H) {
     if (H == NULL) return;
-    _fibHeapRecursiveDestroy(H->minNode);
+    for (int i = 0; i < H->numSlabs; ++i) {
+        free(H->slabs[i]);
+    }
+    free(H->slabs);
+    free(H->slabSizes);
+    free(H->degreeTable);
     free(H);
 }
\ No newline at end of file
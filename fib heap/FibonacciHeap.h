@@ -4,7 +4,6 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <limits.h> // for LLONG_MAX
-#include <math.h>   // for log2, floor
 #include <string.h> // for NULL
 
 // C语言中布尔值的简易定义
@@ -26,10 +25,27 @@ typedef struct FibHeapNode {
 
 /**
  * @brief 斐波那契堆结构体
+ *
+ * 节点来自堆自带的节点池 (若干连续的节点块 slab), 而不是逐个 malloc:
+ * 插入时优先复用空闲链表, 其次在当前块中顺序分配;
+ * 提取的节点回到空闲链表; 重置和销毁都不需要遍历森林。
  */
 typedef struct FibHeap {
     FibHeapNode* minNode;
     int numNodes;
+
+    // --- 节点池 ---
+    FibHeapNode** slabs;    // 节点块数组
+    int* slabSizes;         // 每个块的节点数
+    int numSlabs;           // 已分配的块数
+    int slabArrayCap;       // slabs / slabSizes 数组容量
+    int currentSlab;        // 当前分配所在的块
+    int slabUsed;           // 当前块中已分配的节点数
+    FibHeapNode* freeList;  // 已提取节点的空闲链表 (经 right 指针串联)
+
+    // --- Consolidate 的持久化度数表 ---
+    FibHeapNode** degreeTable; // 按度数索引的根, 两次调用之间保持全 NULL
+    int degreeTableCap;        // 表长度; 只有度数上界超过它时才扩容
 } FibHeap;
 
 /**
@@ -39,7 +55,22 @@ typedef struct FibHeap {
 FibHeap* createFibHeap();
 
 /**
- * @brief 销毁堆 (释放所有节点内存)
+ * @brief 创建一个新的空斐波那契堆, 并按容量提示预分配节点池
+ * @param capacityHint 预计同时存在的最大节点数 (Dijkstra中为 V+1), <= 0 表示不预分配
+ * @return 指向新堆的指针
+ */
+FibHeap* createFibHeapWithCapacity(int capacityHint);
+
+/**
+ * @brief 清空堆, 保留节点池供下次使用 (O(1), 与剩余节点数无关)
+ *
+ * 之前返回的所有 FibHeapNode 指针随即失效。
+ * @param H 指向堆的指针
+ */
+void fibHeapReset(FibHeap* H);
+
+/**
+ * @brief 销毁堆 (释放节点池, 不遍历剩余节点)
  * @param H 指向堆的指针
  */
 void fibHeapDestroy(FibHeap* H);
@@ -75,4 +106,11 @@ void fibHeapDecreaseKey(FibHeap* H, FibHeapNode* x, long long newKey);
  */
 int fibHeapIsEmpty(const FibHeap* H);
 
+/**
+ * @brief 查看最小键 (不提取)
+ * @param H 堆
+ * @return 最小键, 堆为空时返回 LLONG_MAX
+ */
+long long fibHeapMinKey(const FibHeap* H);
+
 #endif // FIBONACCI_HEAP_H
\ No newline at end of file
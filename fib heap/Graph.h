@@ -4,29 +4,74 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+// 二进制文件格式 (快照、地标、收缩层次、距离矩阵) 中各段的对齐字节数 (缓存行)
+#define GRAPH_FILE_ALIGN 64
+
 /**
- * @brief 邻接表节点 (边)
+ * @brief 顶点坐标 (DIMACS .co: 经度 / 纬度 * 10^6)
  */
-typedef struct AdjListNode {
-    int to;                 // 目标顶点ID
-    int weight;             // 边权重 (距离)
-    struct AdjListNode* next; // 指向下一个邻居
-} AdjListNode;
+typedef struct GraphCoord {
+    int x;
+    int y;
+} GraphCoord;
 
 /**
- * @brief 图结构 (邻接表)
+ * @brief 图结构 (压缩稀疏行, CSR)
+ *
+ * 顶点 u 的所有出边连续存放在 [offsets[u], offsets[u+1]) 区间内,
+ * 邻居扫描是对 targets / weights 两个数组的顺序读取, 没有指针追逐。
  */
 typedef struct Graph {
     int numVertices;     // 顶点数量 (基于最大ID)
-    AdjListNode** adj;   // 邻接表数组 (数组的每个元素是一个 AdjListNode 链表的头指针)
+    int numEdges;        // 边数量
+    int* offsets;        // 行偏移数组, 长度 numVertices + 2
+    int* targets;        // 目标顶点ID数组, 长度 numEdges
+    int* weights;        // 边权重数组 (距离), 长度 numEdges
+    void* mapping;       // 若非NULL: 上述数组直接指向只读映射的快照文件 (零拷贝)
+    size_t mappingSize;  // 映射长度 (字节)
+    GraphCoord* coords;  // 顶点坐标 (可选, NULL 表示未加载), 长度 numVertices + 1
+    struct Graph* reverse; // 反向图 (可选, 由 graphBuildReverse 构建, 随本图一起销毁)
 } Graph;
 
+// 并行加载使用的最大线程数
+#define GRAPH_MAX_THREADS 64
+
+/**
+ * @brief 二进制图快照格式
+ *
+ * 文件布局 (本机字节序, 各段按64字节对齐):
+ *   [GraphSnapshotHeader][offsets: int * (V+2)][targets: int * E][weights: int * E]
+ * 加载时整个文件被 mmap 为只读, Graph 的三个数组直接指向映射区,
+ * 不做任何解析和逐边分配。
+ */
+#define GRAPH_SNAPSHOT_MAGIC   "ADSGRAPH"
+#define GRAPH_SNAPSHOT_VERSION 1
+
+typedef struct GraphSnapshotHeader {
+    char magic[8];                 // GRAPH_SNAPSHOT_MAGIC
+    unsigned int version;          // GRAPH_SNAPSHOT_VERSION
+    unsigned int headerSize;       // sizeof(GraphSnapshotHeader)
+    int numVertices;
+    int numEdges;
+    unsigned long long offsetsPos; // 各段在文件中的字节偏移
+    unsigned long long targetsPos;
+    unsigned long long weightsPos;
+    unsigned long long fileSize;
+} GraphSnapshotHeader;
+
 /**
- * @brief 创建一个图
+ * @brief 由边列表构建CSR图 (计数排序, O(V + E))
+ *
+ * 同一起点的边保持它们在输入中的相对顺序。
+ *
  * @param V 顶点数 (最大ID)
- * @return 指向新图的指针
+ * @param m 边数
+ * @param src 起始顶点数组
+ * @param dst 目标顶点数组
+ * @param weight 权重数组
+ * @return 指向新图的指针, 失败则返回 NULL
  */
-Graph* createGraph(int V);
+Graph* createGraphFromEdges(int V, int m, const int* src, const int* dst, const int* weight);
 
 /**
  * @brief 销毁图, 释放所有内存
@@ -35,16 +80,22 @@ Graph* createGraph(int V);
 void graphDestroy(Graph* g);
 
 /**
- * @brief 添加一条有向边
+ * @brief 构建反向图 (每条边 u→v 变为 v→u), 存入 g->reverse
+ *
+ * 双向搜索的后向部分在反向图上运行。已构建时直接返回。
+ * @param g 图
+ * @return 0 成功, -1 失败
+ */
+int graphBuildReverse(Graph* g);
+
+/**
+ * @brief 打印图的邻接存储占用 (每条边字节数), 并与旧的链表布局对比
  * @param g 图
- * @param u 起始顶点
- * @param v 目标顶点
- * @param weight 权重
  */
-void graphAddEdge(Graph* g, int u, int v, int weight);
+void graphReportMemory(const Graph* g);
 
 /**
- * @brief 从文件加载图
+ * @brief 从文件加载图 (使用默认线程数)
  *
  * 预期文件格式: "id1 id2 距离"
  * (这是 convert_format.c 的输出格式)
@@ -54,4 +105,91 @@ void graphAddEdge(Graph* g, int u, int v, int weight);
  */
 Graph* loadGraphFromFile(const char* filename);
 
-#endif // GRAPH_H
\ No newline at end of file
+/**
+ * @brief 从文件加载图 (单遍扫描, 多线程解析与构建)
+ *
+ * 文件被 mmap 后按换行切块并行解析, 再并行做计数排序;
+ * 结果 (包括同一顶点的边顺序) 与顺序加载完全相同。
+ * 打印解析吞吐量 (MB/s)。
+ *
+ * @param filename 输入文件名
+ * @param numThreads 线程数, <= 0 表示使用 graphDefaultThreadCount()
+ * @return 指向加载好的图的指针, 失败则返回 NULL
+ */
+Graph* loadGraphFromFileThreads(const char* filename, int numThreads);
+
+/**
+ * @brief 直接读取 DIMACS .gr 文件 (单遍流式, 无需 convert_format 中间文件)
+ *
+ * 跳过 'c' 注释行, 按 'p sp n m' 头部预分配数组, 读取 'a u v w' 边。
+ *
+ * @param grFilename .gr 文件名
+ * @param coFilename 对应的 .co 坐标文件名, 可为 NULL
+ * @return 指向加载好的图的指针, 失败则返回 NULL
+ */
+Graph* loadGraphFromDimacs(const char* grFilename, const char* coFilename);
+
+/**
+ * @brief 读取 DIMACS .co 坐标文件到 g->coords
+ * @param g 图
+ * @param coFilename 坐标文件名 ("v id x y" 行)
+ * @return 0 成功, -1 失败
+ */
+int graphLoadCoordinates(Graph* g, const char* coFilename);
+
+/**
+ * @brief 默认线程数 (在线CPU数, 上限 GRAPH_MAX_THREADS)
+ */
+int graphDefaultThreadCount(void);
+
+/**
+ * @brief 单调时钟 (秒), 用于计时
+ */
+double graphNowSeconds(void);
+
+/**
+ * @brief 向上对齐到 GRAPH_FILE_ALIGN
+ */
+unsigned long long graphFileAlignUp(unsigned long long x);
+
+/**
+ * @brief 写入一个文件段, 并补零到 GRAPH_FILE_ALIGN 对齐位置
+ * @param pos 当前文件偏移, 返回时已加上写入和补齐的字节数
+ * @return 0 成功, -1 写入失败
+ */
+int graphWriteSection(FILE* file, const void* data, size_t bytes, unsigned long long* pos);
+
+/**
+ * @brief 将图写入二进制快照文件
+ * @param g 图
+ * @param filename 输出文件名
+ * @return 0 成功, -1 失败
+ */
+int graphSaveSnapshot(const Graph* g, const char* filename);
+
+/**
+ * @brief 以只读 mmap 方式加载二进制快照 (零拷贝)
+ *
+ * 返回的图的数组位于只读映射区, 不可修改; graphDestroy 负责 munmap。
+ *
+ * @param filename 快照文件名
+ * @return 指向图的指针, 失败则返回 NULL
+ */
+Graph* loadGraphSnapshot(const char* filename);
+
+/**
+ * @brief 检查文件是否以快照魔数开头
+ * @return 1 (是快照), 0 (否)
+ */
+int isGraphSnapshot(const char* filename);
+
+/**
+ * @brief 按文件内容自动选择加载方式, 并打印加载耗时
+ *
+ * 快照魔数 → mmap 快照; 扩展名 .gr → DIMACS; 其他 → 文本边列表。
+ * @param filename 输入文件名
+ * @return 指向加载好的图的指针, 失败则返回 NULL
+ */
+Graph* loadGraph(const char* filename);
+
+#endif // GRAPH_H
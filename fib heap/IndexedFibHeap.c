@@ -0,0 +1,291 @@
+#include "IndexedFibHeap.h"
+
+/**
+ * @brief 度数上界 D(n) (与 FibonacciHeap 相同: bits + bits/2 + 2 >= 1.44 * log2(n) + 2)
+ */
+static int _indexedFibDegreeBound(int n) {
+    unsigned int x = (unsigned int)(n > 0 ? n : 1);
+    int bits = 0;
+    while (x != 0) {
+        bits++;
+        x >>= 1;
+    }
+    return bits + (bits >> 1) + 2;
+}
+
+/**
+ * @brief 创建堆
+ */
+IndexedFibHeap* createIndexedFibHeap(int capacity) {
+    IndexedFibHeap* H = (IndexedFibHeap*)calloc(1, sizeof(IndexedFibHeap));
+    if (H == NULL) {
+        perror("错误: 无法为堆分配内存");
+        return NULL;
+    }
+    size_t bytes = ((size_t)capacity * sizeof(IndexedFibNode) + 63) & ~(size_t)63; // aligned_alloc 要求长度是对齐的整数倍
+    H->nodes = (IndexedFibNode*)aligned_alloc(64, bytes);
+    // 节点数不会超过容量, 度数表按容量的上界一次分配
+    H->degreeTableCap = _indexedFibDegreeBound(capacity);
+    H->degreeTable = (unsigned int*)malloc(H->degreeTableCap * sizeof(unsigned int));
+    if (H->nodes == NULL || H->degreeTable == NULL) {
+        perror("错误: 无法为堆节点数组分配内存");
+        indexedFibHeapDestroy(H);
+        return NULL;
+    }
+    H->minNode = INDEXED_FIB_NIL;
+    H->numNodes = 0;
+    H->capacity = capacity;
+
+    // 所有节点初始不在堆中, 只在创建时做一次
+    for (int i = 0; i < capacity; i++) {
+        H->nodes[i].left = INDEXED_FIB_DETACHED;
+    }
+    for (int i = 0; i < H->degreeTableCap; i++) {
+        H->degreeTable[i] = INDEXED_FIB_NIL;
+    }
+    return H;
+}
+
+/**
+ * @brief 销毁堆
+ */
+void indexedFibHeapDestroy(IndexedFibHeap* H) {
+    if (H == NULL) return;
+    free(H->nodes);
+    free(H->degreeTable);
+    free(H);
+}
+
+/**
+ * @brief 清空堆
+ */
+void indexedFibHeapReset(IndexedFibHeap* H) {
+    IndexedFibNode* N = H->nodes;
+    // 工作栈经 parent 串联 (清空后不再需要父链接): 先压入所有根, 弹出一个节点时压入它的孩子
+    unsigned int work = INDEXED_FIB_NIL;
+    unsigned int r = H->minNode;
+    if (r != INDEXED_FIB_NIL) {
+        do {
+            N[r].parent = work;
+            work = r;
+            r = N[r].right;
+        } while (r != H->minNode);
+    }
+    while (work != INDEXED_FIB_NIL) {
+        unsigned int x = work;
+        work = N[x].parent;
+        unsigned int c = N[x].child;
+        if (c != INDEXED_FIB_NIL) {
+            do {
+                N[c].parent = work;
+                work = c;
+                c = N[c].right;
+            } while (c != N[x].child);
+        }
+        N[x].left = INDEXED_FIB_DETACHED;
+    }
+    H->minNode = INDEXED_FIB_NIL;
+    H->numNodes = 0;
+}
+
+/**
+ * @brief 将节点x插入到根链表 (插入到 minNode 的左侧)
+ */
+static inline void _indexedFibAddToRootList(IndexedFibHeap* H, unsigned int x) {
+    IndexedFibNode* N = H->nodes;
+    unsigned int m = H->minNode;
+    if (m == INDEXED_FIB_NIL) {
+        H->minNode = x;
+        N[x].left = x;
+        N[x].right = x;
+    } else {
+        unsigned int ml = N[m].left;
+        N[ml].right = x;
+        N[x].left = ml;
+        N[m].left = x;
+        N[x].right = m;
+    }
+    N[x].parent = INDEXED_FIB_NIL; // 根链表节点没有父节点
+}
+
+/**
+ * @brief 插入顶点
+ */
+void indexedFibHeapInsert(IndexedFibHeap* H, long long key, int value) {
+    IndexedFibNode* N = H->nodes;
+    unsigned int x = (unsigned int)value;
+    N[x].key = key;
+    N[x].child = INDEXED_FIB_NIL;
+    N[x].degree = 0;
+    N[x].mark = 0;
+    _indexedFibAddToRootList(H, x);
+    if (key < N[H->minNode].key) {
+        H->minNode = x;
+    }
+    H->numNodes++;
+}
+
+/**
+ * @brief 将根y链接为根x的子节点
+ */
+static inline void _indexedFibLink(IndexedFibNode* N, unsigned int y, unsigned int x) {
+    // 1. 从根链表中移除y
+    N[N[y].left].right = N[y].right;
+    N[N[y].right].left = N[y].left;
+
+    // 2. 将y插入到x的孩子链表 (x->child 的左侧)
+    N[y].parent = x;
+    unsigned int c = N[x].child;
+    if (c == INDEXED_FIB_NIL) {
+        N[x].child = y;
+        N[y].left = y;
+        N[y].right = y;
+    } else {
+        unsigned int cl = N[c].left;
+        N[cl].right = y;
+        N[y].left = cl;
+        N[c].left = y;
+        N[y].right = c;
+    }
+
+    // 3. 更新度数, 重置y的标记
+    N[x].degree++;
+    N[y].mark = 0;
+}
+
+/**
+ * @brief 合并根链表 (与 FibonacciHeap 相同: 先数出根的个数, 再原地遍历, 不分配内存)
+ */
+static void _indexedFibConsolidate(IndexedFibHeap* H) {
+    IndexedFibNode* N = H->nodes;
+    unsigned int* A = H->degreeTable;
+
+    int rootCount = 0;
+    unsigned int current = H->minNode;
+    do {
+        rootCount++;
+        current = N[current].right;
+    } while (current != H->minNode);
+
+    int usedDegree = 0;
+    unsigned int w = H->minNode;
+    for (int i = 0; i < rootCount; i++) {
+        unsigned int x = w;
+        w = N[w].right;
+        int d = N[x].degree;
+
+        while (A[d] != INDEXED_FIB_NIL) {
+            unsigned int y = A[d]; // 另一个度数为d的树
+            if (N[x].key > N[y].key) {
+                unsigned int temp = x;
+                x = y;
+                y = temp;
+            }
+            _indexedFibLink(N, y, x);
+            A[d] = INDEXED_FIB_NIL;
+            d++;
+        }
+        A[d] = x;
+        if (d > usedDegree) usedDegree = d;
+    }
+
+    // 找出新的最小节点, 同时把度数表恢复为全 NIL
+    unsigned int minNode = INDEXED_FIB_NIL;
+    for (int i = 0; i <= usedDegree; ++i) {
+        unsigned int r = A[i];
+        if (r != INDEXED_FIB_NIL) {
+            if (minNode == INDEXED_FIB_NIL || N[r].key < N[minNode].key) {
+                minNode = r;
+            }
+            A[i] = INDEXED_FIB_NIL;
+        }
+    }
+    H->minNode = minNode;
+}
+
+/**
+ * @brief 提取最小顶点
+ */
+int indexedFibHeapExtractMin(IndexedFibHeap* H) {
+    unsigned int z = H->minNode;
+    if (z == INDEXED_FIB_NIL) {
+        fprintf(stderr, "错误: 试图从空堆中提取。\n");
+        return -1;
+    }
+    IndexedFibNode* N = H->nodes;
+
+    // 1. 将z的所有子节点移动到根链表
+    unsigned int first = N[z].child;
+    if (first != INDEXED_FIB_NIL) {
+        unsigned int c = first;
+        do {
+            unsigned int next = N[c].right;
+            _indexedFibAddToRootList(H, c);
+            c = next;
+        } while (c != first);
+    }
+
+    // 2. 从根链表中移除z
+    N[N[z].left].right = N[z].right;
+    N[N[z].right].left = N[z].left;
+
+    // 3. 更新 minNode
+    if (z == N[z].right) {
+        H->minNode = INDEXED_FIB_NIL; // z是唯一的根节点
+    } else {
+        H->minNode = N[z].right; // 临时指向
+        _indexedFibConsolidate(H);
+    }
+
+    H->numNodes--;
+    N[z].left = INDEXED_FIB_DETACHED;
+    return (int)z;
+}
+
+/**
+ * @brief 切割操作 (将x从其父节点y中切除, 移到根链表)
+ */
+static inline void _indexedFibCut(IndexedFibHeap* H, unsigned int x, unsigned int y) {
+    IndexedFibNode* N = H->nodes;
+    if (N[x].right == x) {
+        N[y].child = INDEXED_FIB_NIL; // x是唯一的子节点
+    } else {
+        N[N[x].left].right = N[x].right;
+        N[N[x].right].left = N[x].left;
+        if (N[y].child == x) {
+            N[y].child = N[x].right;
+        }
+    }
+    N[y].degree--;
+    _indexedFibAddToRootList(H, x);
+    N[x].mark = 0;
+}
+
+/**
+ * @brief 减小键值
+ */
+void indexedFibHeapDecreaseKey(IndexedFibHeap* H, int value, long long newKey) {
+    IndexedFibNode* N = H->nodes;
+    unsigned int x = (unsigned int)value;
+    if (N[x].left == INDEXED_FIB_DETACHED || newKey >= N[x].key) return;
+
+    N[x].key = newKey;
+    unsigned int y = N[x].parent;
+    if (y != INDEXED_FIB_NIL && newKey < N[y].key) {
+        // 堆属性被破坏: 切割, 再沿父链级联切割 (迭代)
+        _indexedFibCut(H, x, y);
+        unsigned int z;
+        while ((z = N[y].parent) != INDEXED_FIB_NIL) {
+            if (!N[y].mark) {
+                N[y].mark = 1;
+                break;
+            }
+            _indexedFibCut(H, y, z);
+            y = z;
+        }
+    }
+
+    if (newKey < N[H->minNode].key) {
+        H->minNode = x;
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef INDEXED_FIB_HEAP_H
+#define INDEXED_FIB_HEAP_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h> // for LLONG_MAX
+
+// 空链接
+#define INDEXED_FIB_NIL 0xFFFFFFFFu
+// left 取此值表示节点不在堆中
+#define INDEXED_FIB_DETACHED 0xFFFFFFFEu
+
+/**
+ * @brief 下标斐波那契堆节点 (以顶点ID为下标存放在一个预分配数组中)
+ *
+ * 四个链接都是 32 位无符号下标而不是指针, 度数和标记各占一个字节,
+ * 每个节点 32 字节 (FibHeapNode 为 56 字节), 数组按 64 字节对齐, 一个节点不会跨缓存行。
+ * 根链表和每个孩子链表都是经 left / right 串联的循环双向链表, 与 FibHeapNode 相同。
+ */
+typedef struct IndexedFibNode {
+    long long key;
+    unsigned int parent;
+    unsigned int child;   // 任意一个孩子
+    unsigned int left;    // 不在堆中时为 INDEXED_FIB_DETACHED
+    unsigned int right;
+    unsigned char degree; // 度数不超过 1.44 * log2(n) + 2, 一个字节足够
+    unsigned char mark;   // 0 (FALSE) or 1 (TRUE)
+} IndexedFibNode;
+
+/**
+ * @brief 以下标链接的斐波那契堆
+ *
+ * 算法与 FibonacciHeap 完全相同, 但顶点ID即句柄: Dijkstra 不需要在顶点状态中保存节点指针,
+ * 也没有节点池和空闲链表。创建之后不再分配内存 (度数表按容量一次分配)。
+ */
+typedef struct IndexedFibHeap {
+    IndexedFibNode* nodes;     // 节点数组, 长度 capacity, 下标即顶点ID
+    unsigned int minNode;      // 空堆时为 INDEXED_FIB_NIL
+    int numNodes;
+    int capacity;
+    unsigned int* degreeTable; // Consolidate 用, 两次调用之间保持全 INDEXED_FIB_NIL
+    int degreeTableCap;
+} IndexedFibHeap;
+
+/**
+ * @brief 创建堆
+ * @param capacity 顶点ID上限 (Dijkstra中为 V+1)
+ * @return 指向新堆的指针, 失败则返回 NULL
+ */
+IndexedFibHeap* createIndexedFibHeap(int capacity);
+
+/**
+ * @brief 销毁堆
+ */
+void indexedFibHeapDestroy(IndexedFibHeap* H);
+
+/**
+ * @brief 清空堆 (O(剩余节点数), 空堆时 O(1))
+ */
+void indexedFibHeapReset(IndexedFibHeap* H);
+
+/**
+ * @brief 插入一个顶点 (调用者保证 value 当前不在堆中)
+ * @param H 堆
+ * @param key 键 (距离)
+ * @param value 值 (顶点ID), 同时也是它的节点下标
+ */
+void indexedFibHeapInsert(IndexedFibHeap* H, long long key, int value);
+
+/**
+ * @brief 提取最小键的顶点
+ * @return 顶点ID, 堆为空时返回 -1
+ */
+int indexedFibHeapExtractMin(IndexedFibHeap* H);
+
+/**
+ * @brief 减小一个顶点的键值 (顶点不在堆中或新键不更小时不做任何事)
+ */
+void indexedFibHeapDecreaseKey(IndexedFibHeap* H, int value, long long newKey);
+
+/**
+ * @brief 检查顶点是否在堆中
+ */
+static inline int indexedFibHeapContains(const IndexedFibHeap* H, int value) {
+    return H->nodes[value].left != INDEXED_FIB_DETACHED;
+}
+
+/**
+ * @brief 检查堆是否为空
+ */
+static inline int indexedFibHeapIsEmpty(const IndexedFibHeap* H) {
+    return H->minNode == INDEXED_FIB_NIL;
+}
+
+/**
+ * @brief 查看最小键 (不提取), 堆为空时返回 LLONG_MAX
+ */
+static inline long long indexedFibHeapMinKey(const IndexedFibHeap* H) {
+    return H->minNode != INDEXED_FIB_NIL ? H->nodes[H->minNode].key : LLONG_MAX;
+}
+
+#endif // INDEXED_FIB_HEAP_H
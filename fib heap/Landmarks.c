@@ -0,0 +1,551 @@
+#define _POSIX_C_SOURCE 200809L // mmap
+
+#include "Landmarks.h"
+#include "DijkstraKernel.h"
+#include "BatchQuery.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief k 个地标时的文件大小
+ */
+unsigned long long landmarkFileSize(int numVertices, int k) {
+    unsigned long long pos = graphFileAlignUp(sizeof(LandmarkFileHeader));
+    pos = graphFileAlignUp(pos + (unsigned long long)k * sizeof(int));
+    return graphFileAlignUp(pos + (unsigned long long)(numVertices + 1) * 2 * k * sizeof(unsigned int));
+}
+
+/**
+ * @brief 选择方法的显示名称
+ */
+const char* landmarkSelectionName(LandmarkSelection selection) {
+    return selection == LANDMARK_SELECT_AVOID ? "avoid" : "farthest";
+}
+
+// 内部函数：把一次一对多查询的结果写入距离表的第 column 列 (行跨度 stride)
+// 有限距离超出 32 位存储范围时返回 -1
+static int storeColumn(unsigned int* dist, int stride, int column, const DijkstraContext* ctx) {
+    int V = ctx->g->numVertices;
+    for (int v = 1; v <= V; ++v) {
+        long long d = dijkstraGetDist(ctx, v);
+        if (d == DIJKSTRA_INF) {
+            d = LANDMARK_UNREACHABLE;
+        } else if (d >= LANDMARK_UNREACHABLE) {
+            return -1;
+        }
+        dist[(size_t)v * stride + column] = (unsigned int)d;
+    }
+    return 0;
+}
+
+// 内部函数：运行一次一对多查询并把正向距离存入第 index 列
+static int runForward(DijkstraContext* ctx, int landmark, unsigned int* dist, int stride, int index) {
+    dijkstraRun(ctx, landmark);
+    if (storeColumn(dist, stride, index, ctx) != 0) {
+        fprintf(stderr, "错误: 地标 %d 的距离超出 32 位范围。\n", landmark);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief farthest: 起点取离随机顶点最远的顶点, 之后每次取到已选地标最短距离最大的顶点
+ * @return 选出的地标数, 失败返回 -1
+ */
+static int selectFarthest(DijkstraContext* ctx, int k, int* landmarks, unsigned int* dist, int stride,
+                          double start, LandmarkBuildStats* stats) {
+    int V = ctx->g->numVertices;
+    long long* minDist = (long long*)malloc((V + 1) * sizeof(long long));
+    if (minDist == NULL) {
+        perror("错误: 无法为地标选择分配内存");
+        return -1;
+    }
+
+    dijkstraRun(ctx, rand() % V + 1);
+    for (int v = 1; v <= V; ++v) minDist[v] = dijkstraGetDist(ctx, v);
+
+    int count = 0;
+    while (count < k) {
+        int best = 0;
+        long long bestDist = 0;
+        for (int v = 1; v <= V; ++v) {
+            if (minDist[v] != DIJKSTRA_INF && minDist[v] > bestDist) {
+                bestDist = minDist[v];
+                best = v;
+            }
+        }
+        if (best == 0) break; // 所有可达顶点都已是地标
+
+        if (runForward(ctx, best, dist, stride, count) != 0) {
+            free(minDist);
+            return -1;
+        }
+        for (int v = 1; v <= V; ++v) {
+            long long d = dijkstraGetDist(ctx, v);
+            if (count == 0 || d < minDist[v]) minDist[v] = d;
+        }
+        landmarks[count++] = best;
+        if (stats != NULL) stats->selectSeconds[count - 1] = graphNowSeconds() - start;
+    }
+
+    free(minDist);
+    return count;
+}
+
+typedef struct AvoidEntry {
+    long long dist;
+    int vertex;
+} AvoidEntry;
+
+// 内部函数：按 (距离, 顶点ID) 升序
+static int compareAvoidEntry(const void* a, const void* b) {
+    const AvoidEntry* x = (const AvoidEntry*)a;
+    const AvoidEntry* y = (const AvoidEntry*)b;
+    if (x->dist != y->dist) return x->dist < y->dist ? -1 : 1;
+    return x->vertex - y->vertex;
+}
+
+/**
+ * @brief avoid (Goldberg & Werneck): 从随机根 r 建最短路径树, 顶点权重为
+ *        d(r,v) - 现有地标给出的下界; 子树中含地标的顶点权重清零。
+ *        沿子树权重最大的孩子一直走到叶子, 该叶子成为新地标。
+ *
+ * 下界只用正向距离 d(Li,v) - d(Li,r) (选点阶段尚未计算反向距离)。
+ * @return 选出的地标数, 失败返回 -1
+ */
+static int selectAvoid(DijkstraContext* ctx, int k, int* landmarks, unsigned int* dist, int stride,
+                       double start, LandmarkBuildStats* stats) {
+    const Graph* reverse = ctx->g->reverse;
+    int V = ctx->g->numVertices;
+    int* parent = (int*)malloc((V + 1) * sizeof(int));
+    int* bestChild = (int*)malloc((V + 1) * sizeof(int));
+    long long* size = (long long*)malloc((V + 1) * sizeof(long long));
+    long long* bestSize = (long long*)malloc((V + 1) * sizeof(long long));
+    char* hasLandmark = (char*)malloc(V + 1);
+    char* isLandmark = (char*)calloc(V + 1, 1);
+    AvoidEntry* order = (AvoidEntry*)malloc(V * sizeof(AvoidEntry));
+    int count = -1;
+    if (parent == NULL || bestChild == NULL || size == NULL || bestSize == NULL ||
+        hasLandmark == NULL || isLandmark == NULL || order == NULL) {
+        perror("错误: 无法为地标选择分配内存");
+        goto done;
+    }
+
+    count = 0;
+    while (count < k) {
+        int root = rand() % V + 1;
+        for (int tries = 0; isLandmark[root] && tries < V; ++tries) root = root % V + 1;
+        if (isLandmark[root]) break;
+        dijkstraRun(ctx, root);
+
+        int n = 0;
+        for (int v = 1; v <= V; ++v) {
+            long long d = dijkstraGetDist(ctx, v);
+            if (d != DIJKSTRA_INF) {
+                order[n].dist = d;
+                order[n].vertex = v;
+                n++;
+            }
+        }
+        qsort(order, n, sizeof(AvoidEntry), compareAvoidEntry);
+
+        // 父节点: 满足 d(u) + w = d(v) 且在 (距离, ID) 顺序中排在 v 之前的入边起点
+        const unsigned int* rootRow = dist + (size_t)root * stride;
+        for (int i = 0; i < n; ++i) {
+            int v = order[i].vertex;
+            long long dv = order[i].dist;
+            parent[v] = 0;
+            for (int e = reverse->offsets[v]; e < reverse->offsets[v + 1]; ++e) {
+                int u = reverse->targets[e];
+                long long du = dijkstraGetDist(ctx, u);
+                if (du != DIJKSTRA_INF && du + reverse->weights[e] == dv && (du < dv || u < v)) {
+                    parent[v] = u;
+                    break;
+                }
+            }
+
+            const unsigned int* row = dist + (size_t)v * stride;
+            long long lowerBound = 0;
+            for (int l = 0; l < count; ++l) {
+                // 查询时不可达值直接参与计算仍然可采纳, 但这里要的是下界的大小:
+                // 任一端不可达时差值是 2^32 量级的假值, 会压倒真实的误差, 按 0 处理
+                if (row[l] == LANDMARK_UNREACHABLE || rootRow[l] == LANDMARK_UNREACHABLE) continue;
+                long long b = (long long)row[l] - rootRow[l];
+                if (b > lowerBound) lowerBound = b;
+            }
+            size[v] = dv - lowerBound;
+            bestChild[v] = 0;
+            bestSize[v] = 0;
+            hasLandmark[v] = isLandmark[v];
+        }
+
+        // 逆序累加: 处理 v 时它的所有孩子都已处理完
+        for (int i = n - 1; i >= 0; --i) {
+            int v = order[i].vertex;
+            int p = parent[v];
+            if (hasLandmark[v]) size[v] = 0;
+            if (p == 0) continue;
+            if (hasLandmark[v]) hasLandmark[p] = 1;
+            size[p] += size[v];
+            if (size[v] > bestSize[p]) {
+                bestSize[p] = size[v];
+                bestChild[p] = v;
+            }
+        }
+
+        int leaf = root;
+        while (bestChild[leaf] != 0) leaf = bestChild[leaf];
+        if (leaf == root) {
+            // 整棵树都被已有地标覆盖: 退化为离根最远的非地标顶点
+            for (int i = n - 1; i >= 0 && (leaf == root || isLandmark[leaf]); --i) leaf = order[i].vertex;
+            if (leaf == root || isLandmark[leaf]) break;
+        }
+
+        if (runForward(ctx, leaf, dist, stride, count) != 0) {
+            count = -1;
+            goto done;
+        }
+        isLandmark[leaf] = 1;
+        landmarks[count++] = leaf;
+        if (stats != NULL) stats->selectSeconds[count - 1] = graphNowSeconds() - start;
+    }
+
+done:
+    free(parent);
+    free(bestChild);
+    free(size);
+    free(bestSize);
+    free(hasLandmark);
+    free(isLandmark);
+    free(order);
+    return count;
+}
+
+// --- 反向阶段的批量查询回调: 每个工作线程在反向图上运行一对多查询 ---
+
+typedef struct ReverseJob {
+    const Graph* reverse;
+    PriorityQueueKind kind;
+    const int* landmarks;
+    unsigned int* columns;   // 按地标连续存放的临时结果, 长度 k * (V+1), 避免多个线程写同一行
+    int failed;
+} ReverseJob;
+
+static void* reverseCreateWorker(void* userData) {
+    ReverseJob* job = (ReverseJob*)userData;
+    return createDijkstraContextWithQueue(job->reverse, job->kind);
+}
+
+static void reverseRunQuery(void* worker, int index, void* userData) {
+    ReverseJob* job = (ReverseJob*)userData;
+    DijkstraContext* ctx = (DijkstraContext*)worker;
+    int V = job->reverse->numVertices;
+    dijkstraRun(ctx, job->landmarks[index]);
+    if (storeColumn(job->columns + (size_t)index * (V + 1), 1, 0, ctx) != 0) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void reverseDestroyWorker(void* worker) {
+    dijkstraContextDestroy((DijkstraContext*)worker);
+}
+
+/**
+ * @brief 选择地标并计算距离表
+ */
+LandmarkSet* landmarkBuild(Graph* g, int k, LandmarkSelection selection, PriorityQueueKind kind,
+                           int numThreads, unsigned int seed, LandmarkBuildStats* stats) {
+    if (k <= 0 || k > LANDMARK_MAX_COUNT) {
+        fprintf(stderr, "错误: 地标数 %d 无效 (1 .. %d)。\n", k, LANDMARK_MAX_COUNT);
+        return NULL;
+    }
+    if (k > g->numVertices) k = g->numVertices;
+    if (graphBuildReverse(g) != 0) return NULL;
+    if (stats != NULL) memset(stats, 0, sizeof(LandmarkBuildStats));
+
+    int V = g->numVertices;
+    int stride = 2 * k;
+    size_t landmarksBytes = (size_t)graphFileAlignUp((unsigned long long)k * sizeof(int));
+    size_t distBytes = (size_t)(V + 1) * stride * sizeof(unsigned int);
+    LandmarkSet* set = (LandmarkSet*)calloc(1, sizeof(LandmarkSet));
+    char* buffer = (char*)malloc(landmarksBytes + distBytes);
+    DijkstraContext* ctx = createDijkstraContextWithQueue(g, kind);
+    if (set == NULL || buffer == NULL || ctx == NULL) {
+        perror("错误: 无法为地标分配内存");
+        free(set);
+        free(buffer);
+        dijkstraContextDestroy(ctx);
+        return NULL;
+    }
+    int* landmarks = (int*)buffer;
+    unsigned int* dist = (unsigned int*)(buffer + landmarksBytes);
+    for (int i = 0; i < stride; ++i) dist[i] = LANDMARK_UNREACHABLE; // 第 0 行不对应任何顶点
+    set->buffer = buffer;
+    set->landmarks = landmarks;
+    set->dist = dist;
+    set->numVertices = V;
+    set->numEdges = g->numEdges;
+    set->selection = selection;
+
+    // --- 1. 顺序选点, 同时得到正向距离 ---
+    srand(seed);
+    double start = graphNowSeconds();
+    int count = selection == LANDMARK_SELECT_AVOID
+                    ? selectAvoid(ctx, k, landmarks, dist, stride, start, stats)
+                    : selectFarthest(ctx, k, landmarks, dist, stride, start, stats);
+    dijkstraContextDestroy(ctx);
+    if (count <= 0) {
+        if (count == 0) fprintf(stderr, "错误: 图中没有可选的地标。\n");
+        landmarkSetDestroy(set);
+        return NULL;
+    }
+
+    // --- 2. 在反向图上并行计算 d(v, L) ---
+    ReverseJob job;
+    job.reverse = g->reverse;
+    job.kind = kind;
+    job.landmarks = landmarks;
+    job.columns = (unsigned int*)malloc((size_t)count * (V + 1) * sizeof(unsigned int));
+    job.failed = 0;
+    int* indices = (int*)malloc(count * sizeof(int));
+    if (job.columns == NULL || indices == NULL) {
+        perror("错误: 无法为地标分配内存");
+        free(job.columns);
+        free(indices);
+        landmarkSetDestroy(set);
+        return NULL;
+    }
+    for (int i = 0; i < count; ++i) indices[i] = i;
+
+    BatchWorkerOps ops = {reverseCreateWorker, reverseRunQuery, reverseDestroyWorker};
+    BatchStats batch;
+    start = graphNowSeconds();
+    int status = runBatchQueries(indices, count, numThreads < count ? numThreads : count, &ops, &job, &batch);
+    if (status == 0 && job.failed) {
+        fprintf(stderr, "错误: 到地标的距离超出 32 位范围。\n");
+        status = -1;
+    }
+    if (status == 0) {
+        // 转置到按顶点存放的距离表 (选点少于 k 时, 把正向列向前挪紧凑)
+        int newStride = 2 * count;
+        for (int v = 1; v <= V; ++v) {
+            const unsigned int* src = dist + (size_t)v * stride;
+            unsigned int* row = dist + (size_t)v * newStride;
+            memmove(row, src, count * sizeof(unsigned int));
+            for (int i = 0; i < count; ++i) row[count + i] = job.columns[(size_t)i * (V + 1) + v];
+        }
+        for (int i = 0; i < newStride; ++i) dist[i] = LANDMARK_UNREACHABLE;
+        if (stats != NULL) {
+            stats->reverseSeconds = graphNowSeconds() - start;
+            stats->numThreads = batch.numThreads;
+        }
+    }
+    free(job.columns);
+    free(indices);
+    if (status != 0) {
+        landmarkSetDestroy(set);
+        return NULL;
+    }
+
+    set->numLandmarks = count;
+    return set;
+}
+
+/**
+ * @brief 写入地标文件
+ */
+int landmarkSave(const LandmarkSet* set, const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) {
+        perror("错误: 无法创建地标文件");
+        return -1;
+    }
+
+    int k = set->numLandmarks;
+    LandmarkFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LANDMARK_FILE_MAGIC, sizeof(header.magic));
+    header.version = LANDMARK_FILE_VERSION;
+    header.headerSize = sizeof(LandmarkFileHeader);
+    header.numVertices = set->numVertices;
+    header.numEdges = set->numEdges;
+    header.numLandmarks = k;
+    header.selection = set->selection;
+    header.landmarksPos = graphFileAlignUp(sizeof(LandmarkFileHeader));
+    header.distPos = graphFileAlignUp(header.landmarksPos + (unsigned long long)k * sizeof(int));
+    header.fileSize = landmarkFileSize(set->numVertices, k);
+
+    unsigned long long pos = 0;
+    int status = graphWriteSection(file, &header, sizeof(header), &pos);
+    if (status == 0) status = graphWriteSection(file, set->landmarks, (size_t)k * sizeof(int), &pos);
+    if (status == 0) {
+        status = graphWriteSection(file, set->dist, (size_t)(set->numVertices + 1) * 2 * k * sizeof(unsigned int), &pos);
+    }
+
+    if (fclose(file) != 0) status = -1;
+    if (status != 0) {
+        perror("错误: 写入地标文件失败");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief mmap 加载地标文件
+ */
+LandmarkSet* landmarkLoad(const char* filename, const Graph* g) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("错误: 无法打开地标文件");
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(LandmarkFileHeader)) {
+        fprintf(stderr, "错误: 地标文件 %s 过小或无法读取。\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror("错误: 无法映射地标文件");
+        return NULL;
+    }
+
+    const LandmarkFileHeader* header = (const LandmarkFileHeader*)base;
+    int k = header->numLandmarks;
+    if (memcmp(header->magic, LANDMARK_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != LANDMARK_FILE_VERSION ||
+        header->headerSize != sizeof(LandmarkFileHeader) ||
+        header->numVertices < 0 || k <= 0 || k > LANDMARK_MAX_COUNT ||
+        header->fileSize != landmarkFileSize(header->numVertices, k) ||
+        header->fileSize > size) {
+        fprintf(stderr, "错误: %s 不是有效的地标文件 (版本 %d)。\n", filename, LANDMARK_FILE_VERSION);
+        munmap(base, size);
+        return NULL;
+    }
+    if (g != NULL && (header->numVertices != g->numVertices || header->numEdges != g->numEdges)) {
+        fprintf(stderr, "错误: 地标文件 %s 对应的图 (%d 个顶点, %d 条边) 与当前图不一致。\n",
+                filename, header->numVertices, header->numEdges);
+        munmap(base, size);
+        return NULL;
+    }
+
+    LandmarkSet* set = (LandmarkSet*)calloc(1, sizeof(LandmarkSet));
+    if (set == NULL) {
+        perror("错误: 无法为地标分配内存");
+        munmap(base, size);
+        return NULL;
+    }
+    const char* bytes = (const char*)base;
+    set->numVertices = header->numVertices;
+    set->numEdges = header->numEdges;
+    set->numLandmarks = k;
+    set->selection = (LandmarkSelection)header->selection;
+    set->landmarks = (const int*)(bytes + header->landmarksPos);
+    set->dist = (const unsigned int*)(bytes + header->distPos);
+    set->mapping = base;
+    set->mappingSize = size;
+    return set;
+}
+
+/**
+ * @brief 销毁地标集合
+ */
+void landmarkSetDestroy(LandmarkSet* set) {
+    if (set == NULL) return;
+    if (set->mapping != NULL) munmap(set->mapping, set->mappingSize);
+    free(set->buffer);
+    free(set);
+}
+
+/**
+ * @brief 创建 ALT 查询上下文
+ */
+AltContext* createAltContext(const Graph* g, const LandmarkSet* set, PriorityQueueKind kind) {
+    if (set->numVertices != g->numVertices) {
+        fprintf(stderr, "错误: 地标集合与图的顶点数不一致。\n");
+        return NULL;
+    }
+    AltContext* ac = (AltContext*)calloc(1, sizeof(AltContext));
+    if (ac == NULL) {
+        perror("错误: 无法为ALT上下文分配内存");
+        return NULL;
+    }
+    ac->set = set;
+    ac->numActive = set->numLandmarks;
+    ac->base = createDijkstraContextWithQueue(g, kind);
+    ac->hcache = (long long*)malloc((g->numVertices + 1) * sizeof(long long));
+    if (ac->base == NULL || ac->hcache == NULL) {
+        perror("错误: 无法为ALT上下文分配内存");
+        altContextDestroy(ac);
+        return NULL;
+    }
+    return ac;
+}
+
+/**
+ * @brief 销毁 ALT 查询上下文
+ */
+void altContextDestroy(AltContext* ac) {
+    if (ac == NULL) return;
+    dijkstraContextDestroy(ac->base);
+    free(ac->hcache);
+    free(ac);
+}
+
+// 内部函数：v 到当前终点的三角不等式下界
+static inline long long altHeuristic(const AltContext* ac, int v) {
+    int k = ac->set->numLandmarks;
+    const unsigned int* row = ac->set->dist + (size_t)v * 2 * k;
+    const unsigned int* target = ac->targetRow;
+    long long best = 0;
+    for (int i = 0; i < ac->numActive; ++i) {
+        long long toward = (long long)target[i] - row[i];         // d(Li,t) - d(Li,v)
+        long long away = (long long)row[k + i] - target[k + i];   // d(v,Li) - d(t,Li)
+        if (toward > best) best = toward;
+        if (away > best) best = away;
+    }
+    return best;
+}
+
+// --- 特化内核 (每种队列一个) ---
+
+#define ALT_DEFINE_QUEUE_KERNEL(KIND, SUFFIX, QUEUE_T, CREATE, DESTROY,                            \
+                                RESET, PUSH, DECREASE, POP, EMPTY, MINKEY)                         \
+    DIJKSTRA_DEFINE_ASTAR_KERNEL(alt##SUFFIX, QUEUE_T, RESET, PUSH, DECREASE, POP, EMPTY,          \
+                                 AltContext, altHeuristic)
+
+DIJKSTRA_QUEUE_LIST(ALT_DEFINE_QUEUE_KERNEL)
+
+#undef ALT_DEFINE_QUEUE_KERNEL
+
+/**
+ * @brief ALT 点对点查询
+ */
+long long altQuery(AltContext* ac, int source, int target) {
+    DijkstraContext* ctx = ac->base;
+    int V = ctx->g->numVertices;
+    if (source <= 0 || source > V || target <= 0 || target > V) {
+        fprintf(stderr, "错误: 起点 %d 或终点 %d 无效。\n", source, target);
+        return -1;
+    }
+    if (ac->numActive < 0 || ac->numActive > ac->set->numLandmarks) ac->numActive = ac->set->numLandmarks;
+    ac->targetRow = ac->set->dist + (size_t)target * 2 * ac->set->numLandmarks;
+
+    switch (ctx->kind) {
+#define ALT_CASE(KIND, SUFFIX, QUEUE_T, ...) \
+        case KIND: alt##SUFFIX(ctx, (QUEUE_T*)ctx->pq, ac, ac->hcache, source, target); break;
+        DIJKSTRA_QUEUE_LIST(ALT_CASE)
+#undef ALT_CASE
+        default: return -1;
+    }
+    return dijkstraGetDist(ctx, target);
+}
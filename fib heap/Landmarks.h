@@ -0,0 +1,156 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "Graph.h"
+#include "Dijkstra.h"
+
+/**
+ * @brief ALT (A*, Landmarks, Triangle inequality) 地标文件格式
+ *
+ * 文件布局 (本机字节序, 各段按64字节对齐):
+ *   [LandmarkFileHeader][landmarks: int * k][dist: unsigned int * (V+1) * 2k]
+ * dist 按顶点连续存放: 第 v 行为 [d(L0,v) .. d(Lk-1,v), d(v,L0) .. d(v,Lk-1)],
+ * 一次求下界只读一行 (2k 个整数, k = 8 时恰好一条缓存行)。
+ * 加载时整个文件被 mmap 为只读, 不做任何解析。
+ */
+#define LANDMARK_FILE_MAGIC   "ADSLMARK"
+#define LANDMARK_FILE_VERSION 1
+
+// 地标数量上限
+#define LANDMARK_MAX_COUNT 64
+
+// 不可达距离的存储值。它大于所有有限距离, 直接参与下界计算仍然可采纳且一致,
+// 查询时无需特殊处理
+#define LANDMARK_UNREACHABLE 0xFFFFFFFFu
+
+/**
+ * @brief 地标选择方法
+ */
+typedef enum LandmarkSelection {
+    LANDMARK_SELECT_FARTHEST = 0, // 每次选离已有地标最远的顶点
+    LANDMARK_SELECT_AVOID,        // Goldberg-Werneck avoid: 在下界最差的最短路径树分支末端放置地标
+} LandmarkSelection;
+
+typedef struct LandmarkFileHeader {
+    char magic[8];                  // LANDMARK_FILE_MAGIC
+    unsigned int version;           // LANDMARK_FILE_VERSION
+    unsigned int headerSize;        // sizeof(LandmarkFileHeader)
+    int numVertices;                // 图的顶点数 / 边数 (加载时用于校验是否为同一张图)
+    int numEdges;
+    int numLandmarks;
+    int selection;                  // LandmarkSelection
+    unsigned long long landmarksPos; // 各段在文件中的字节偏移
+    unsigned long long distPos;
+    unsigned long long fileSize;
+} LandmarkFileHeader;
+
+/**
+ * @brief 地标及其距离表
+ */
+typedef struct LandmarkSet {
+    int numVertices;
+    int numEdges;
+    int numLandmarks;            // k
+    LandmarkSelection selection;
+    const int* landmarks;        // 地标顶点, 长度 k
+    const unsigned int* dist;    // 距离表, 长度 (V+1) * 2k, 布局见文件格式说明
+    void* buffer;                // 若非NULL: 上述数组位于此堆内存 (预处理结果)
+    void* mapping;               // 若非NULL: 上述数组直接指向只读映射的文件 (零拷贝)
+    size_t mappingSize;          // 映射长度 (字节)
+} LandmarkSet;
+
+/**
+ * @brief 预处理耗时
+ *
+ * 两种选择方法都是贪心的, 前 j 个地标与只选 j 个时完全相同,
+ * 所以一次预处理就给出了所有 j <= k 的选点耗时。
+ */
+typedef struct LandmarkBuildStats {
+    double selectSeconds[LANDMARK_MAX_COUNT]; // 选出前 j+1 个地标 (含正向距离) 的累计耗时
+    double reverseSeconds;                    // 并行计算所有反向距离的耗时
+    int numThreads;                           // 反向阶段实际使用的线程数
+} LandmarkBuildStats;
+
+/**
+ * @brief 选择地标并计算距离表
+ *
+ * 选点阶段逐个运行一对多 Dijkstra (选点依赖之前的结果, 只能顺序执行),
+ * 同时得到每个地标的正向距离 d(L, v); 之后在反向图上并行运行 k 次一对多查询
+ * 得到 d(v, L)。会按需构建 g->reverse。
+ *
+ * @param g 图
+ * @param k 地标数 (1 .. LANDMARK_MAX_COUNT)
+ * @param selection 选择方法
+ * @param kind 一对多查询使用的优先队列
+ * @param numThreads 反向阶段的线程数
+ * @param seed 随机种子 (选择起始顶点)
+ * @param stats 输出耗时, 可为 NULL
+ * @return 地标集合 (顶点数少于 k 时会少选), 失败则返回 NULL
+ */
+LandmarkSet* landmarkBuild(Graph* g, int k, LandmarkSelection selection, PriorityQueueKind kind,
+                           int numThreads, unsigned int seed, LandmarkBuildStats* stats);
+
+/**
+ * @brief 写入地标文件
+ * @return 0 成功, -1 失败
+ */
+int landmarkSave(const LandmarkSet* set, const char* filename);
+
+/**
+ * @brief 以只读 mmap 方式加载地标文件 (零拷贝)
+ * @param filename 文件名
+ * @param g 对应的图 (校验顶点数 / 边数), 可为 NULL
+ * @return 地标集合, 失败则返回 NULL
+ */
+LandmarkSet* landmarkLoad(const char* filename, const Graph* g);
+
+/**
+ * @brief 销毁地标集合 (释放内存或 munmap)
+ */
+void landmarkSetDestroy(LandmarkSet* set);
+
+/**
+ * @brief k 个地标时的文件大小 (字节)
+ */
+unsigned long long landmarkFileSize(int numVertices, int k);
+
+/**
+ * @brief 选择方法的显示名称
+ */
+const char* landmarkSelectionName(LandmarkSelection selection);
+
+/**
+ * @brief ALT 点对点查询上下文
+ *
+ * 下界 h(v) = max_i max(d(Li,t) - d(Li,v), d(v,Li) - d(t,Li), 0), 由三角不等式可采纳且一致。
+ */
+typedef struct AltContext {
+    DijkstraContext* base;       // 距离 / 堆等查询状态 (复用普通 Dijkstra 上下文)
+    long long* hcache;           // 本次查询中各顶点的下界, 仅对已触及的顶点有效
+    const LandmarkSet* set;
+    int numActive;               // 使用前 numActive 个地标 (默认全部)
+    const unsigned int* targetRow; // 当前终点在距离表中的行
+} AltContext;
+
+/**
+ * @brief 创建 ALT 查询上下文
+ * @param g 图 (必须与地标文件对应)
+ * @param set 地标集合, 生命周期须长于上下文
+ * @param kind 优先队列种类
+ * @return 指向上下文的指针, 失败则返回 NULL
+ */
+AltContext* createAltContext(const Graph* g, const LandmarkSet* set, PriorityQueueKind kind);
+
+/**
+ * @brief 销毁 ALT 查询上下文
+ */
+void altContextDestroy(AltContext* ac);
+
+/**
+ * @brief ALT 点对点查询
+ * @return 最短距离 (不可达时为 DIJKSTRA_INF), 顶点无效时返回 -1;
+ *         ac->base->numSettled 为确定的顶点数
+ */
+long long altQuery(AltContext* ac, int source, int target);
+
+#endif // LANDMARKS_H
@@ -0,0 +1,378 @@
+#include "ManyToMany.h"
+#include "BinaryHeap.h"
+#include "BatchQuery.h"
+
+#include <string.h>
+
+/**
+ * @brief 桶项 / 搜索确定的顶点
+ */
+typedef struct BucketEntry {
+    long long dist;
+    int id;                // 桶中为终点下标, 搜索结果中为顶点
+} BucketEntry;
+
+/**
+ * @brief 每个工作线程的搜索状态 (向上搜索只访问几百个顶点, 用时间戳代替每次清零)
+ */
+typedef struct UpwardSearch {
+    BinaryHeap* heap;
+    long long* dist;
+    unsigned int* stamp;
+    unsigned int epoch;
+    int numVertices;
+    BucketEntry* settled;  // 未被 stall 的已确定顶点
+    int numSettled;
+    int capacity;
+    long long totalSettled;
+    struct ManyToManyJob* job;
+} UpwardSearch;
+
+typedef struct ManyToManyJob {
+    const ContractionHierarchy* ch;
+    const int* sources;
+    const int* targets;
+    int numTargets;
+    BucketEntry** hits;        // 后向阶段: 每个终点的搜索结果 (各线程写不同的下标)
+    int* numHits;
+    const int* bucketOffsets;  // 前向阶段: 按顶点的桶, 长度 V+2
+    const BucketEntry* buckets;
+    long long* matrix;
+    long long numSettled;
+    int failed;
+} ManyToManyJob;
+
+static void searchDestroy(UpwardSearch* s) {
+    if (s == NULL) return;
+    binaryHeapDestroy(s->heap);
+    free(s->dist);
+    free(s->stamp);
+    free(s->settled);
+    free(s);
+}
+
+static UpwardSearch* createSearch(ManyToManyJob* job) {
+    int V = job->ch->numVertices;
+    UpwardSearch* s = (UpwardSearch*)calloc(1, sizeof(UpwardSearch));
+    if (s == NULL) return NULL;
+    s->job = job;
+    s->numVertices = V;
+    s->heap = createBinaryHeap(V + 1);
+    s->dist = (long long*)malloc((V + 1) * sizeof(long long));
+    s->stamp = (unsigned int*)calloc(V + 1, sizeof(unsigned int));
+    s->capacity = 256;
+    s->settled = (BucketEntry*)malloc(s->capacity * sizeof(BucketEntry));
+    if (s->heap == NULL || s->dist == NULL || s->stamp == NULL || s->settled == NULL) {
+        searchDestroy(s);
+        return NULL;
+    }
+    return s;
+}
+
+/**
+ * @brief 在 g 中从 source 出发的完整向上搜索, 结果存入 s->settled
+ *
+ * stallGraph 是另一个方向的搜索图: 它在 u 处的弧 u→x 对应本方向的 x→u (x 层次更高)。
+ * 若 dist[x] + w < dist[u], 则 u 的距离不是最短的, 不展开 u 也不记录它。
+ * @return 0 成功, -1 内存不足
+ */
+static int upwardSearch(UpwardSearch* s, const Graph* g, const Graph* stallGraph, int source) {
+    if (++s->epoch == 0) {
+        memset(s->stamp, 0, (s->numVertices + 1) * sizeof(unsigned int));
+        s->epoch = 1;
+    }
+    const unsigned int epoch = s->epoch;
+    long long* dist = s->dist;
+    unsigned int* stamp = s->stamp;
+    BinaryHeap* heap = s->heap;
+    binaryHeapReset(heap);
+    s->numSettled = 0;
+    stamp[source] = epoch;
+    dist[source] = 0;
+    binaryHeapInsert(heap, 0, source);
+
+    while (!binaryHeapIsEmpty(heap)) {
+        int u = binaryHeapExtractMin(heap);
+        long long du = dist[u];
+        s->totalSettled++;
+
+        int stalled = 0;
+        for (int e = stallGraph->offsets[u]; e < stallGraph->offsets[u + 1]; ++e) {
+            int x = stallGraph->targets[e];
+            if (stamp[x] == epoch && dist[x] + stallGraph->weights[e] < du) {
+                stalled = 1;
+                break;
+            }
+        }
+        if (stalled) continue;
+
+        if (s->numSettled == s->capacity) {
+            int capacity = s->capacity * 2;
+            BucketEntry* settled = (BucketEntry*)realloc(s->settled, capacity * sizeof(BucketEntry));
+            if (settled == NULL) return -1;
+            s->settled = settled;
+            s->capacity = capacity;
+        }
+        s->settled[s->numSettled].id = u;
+        s->settled[s->numSettled].dist = du;
+        s->numSettled++;
+
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            int v = g->targets[e];
+            long long nd = du + g->weights[e];
+            if (stamp[v] != epoch) {
+                stamp[v] = epoch;
+                dist[v] = nd;
+                binaryHeapInsert(heap, nd, v);
+            } else if (nd < dist[v]) {
+                dist[v] = nd;
+                binaryHeapDecreaseKey(heap, v, nd);
+            }
+        }
+    }
+    return 0;
+}
+
+// --- 批量查询回调: 工作线程各自持有一个 UpwardSearch, 查询参数为起点 / 终点的下标 ---
+
+static void* tableCreateWorker(void* userData) {
+    return createSearch((ManyToManyJob*)userData);
+}
+
+static void tableDestroyWorker(void* worker) {
+    UpwardSearch* s = (UpwardSearch*)worker;
+    __atomic_fetch_add(&s->job->numSettled, s->totalSettled, __ATOMIC_RELAXED);
+    searchDestroy(s);
+}
+
+static void backwardRunQuery(void* worker, int index, void* userData) {
+    ManyToManyJob* job = (ManyToManyJob*)userData;
+    UpwardSearch* s = (UpwardSearch*)worker;
+    if (upwardSearch(s, job->ch->downward, job->ch->upward, job->targets[index]) != 0) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    BucketEntry* hits = (BucketEntry*)malloc((s->numSettled > 0 ? s->numSettled : 1) * sizeof(BucketEntry));
+    if (hits == NULL) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    memcpy(hits, s->settled, s->numSettled * sizeof(BucketEntry));
+    job->hits[index] = hits;
+    job->numHits[index] = s->numSettled;
+}
+
+static void forwardRunQuery(void* worker, int index, void* userData) {
+    ManyToManyJob* job = (ManyToManyJob*)userData;
+    UpwardSearch* s = (UpwardSearch*)worker;
+    if (upwardSearch(s, job->ch->upward, job->ch->downward, job->sources[index]) != 0) {
+        __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    long long* row = job->matrix + (size_t)index * job->numTargets;
+    for (int j = 0; j < job->numTargets; ++j) row[j] = DIJKSTRA_INF;
+    for (int i = 0; i < s->numSettled; ++i) {
+        int v = s->settled[i].id;
+        long long dv = s->settled[i].dist;
+        for (int b = job->bucketOffsets[v]; b < job->bucketOffsets[v + 1]; ++b) {
+            const BucketEntry* entry = &job->buckets[b];
+            long long d = dv + entry->dist;
+            if (d < row[entry->id]) row[entry->id] = d;
+        }
+    }
+}
+
+// 内部函数：0, 1, ..., n-1
+static int* indexArray(int n) {
+    int* indices = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (indices == NULL) return NULL;
+    for (int i = 0; i < n; ++i) indices[i] = i;
+    return indices;
+}
+
+/**
+ * @brief 计算 S × T 距离矩阵
+ */
+long long* manyToManyTable(const ContractionHierarchy* ch, const int* sources, int numSources,
+                           const int* targets, int numTargets, int numThreads, ManyToManyStats* stats) {
+    int V = ch->numVertices;
+    if (numSources <= 0 || numTargets <= 0) {
+        fprintf(stderr, "错误: 起点和终点集合不能为空。\n");
+        return NULL;
+    }
+    for (int i = 0; i < numSources; ++i) {
+        if (sources[i] <= 0 || sources[i] > V) {
+            fprintf(stderr, "错误: 起点 %d 无效。\n", sources[i]);
+            return NULL;
+        }
+    }
+    for (int j = 0; j < numTargets; ++j) {
+        if (targets[j] <= 0 || targets[j] > V) {
+            fprintf(stderr, "错误: 终点 %d 无效。\n", targets[j]);
+            return NULL;
+        }
+    }
+    if (numThreads <= 0) numThreads = 1;
+
+    double start = graphNowSeconds();
+    ManyToManyJob job;
+    memset(&job, 0, sizeof(job));
+    job.ch = ch;
+    job.sources = sources;
+    job.targets = targets;
+    job.numTargets = numTargets;
+    job.hits = (BucketEntry**)calloc(numTargets, sizeof(BucketEntry*));
+    job.numHits = (int*)calloc(numTargets, sizeof(int));
+    int* bucketOffsets = (int*)calloc(V + 2, sizeof(int));
+    BucketEntry* buckets = NULL;
+    long long* matrix = (long long*)malloc((size_t)numSources * numTargets * sizeof(long long));
+    int* targetIndices = indexArray(numTargets);
+    int* sourceIndices = indexArray(numSources);
+    if (job.hits == NULL || job.numHits == NULL || bucketOffsets == NULL || matrix == NULL ||
+        targetIndices == NULL || sourceIndices == NULL) {
+        perror("错误: 无法为距离表分配内存");
+        goto fail;
+    }
+
+    // 后向阶段
+    BatchWorkerOps backwardOps = {tableCreateWorker, backwardRunQuery, tableDestroyWorker};
+    double phase = graphNowSeconds();
+    if (runBatchQueries(targetIndices, numTargets, numThreads < numTargets ? numThreads : numTargets,
+                        &backwardOps, &job, NULL) != 0 || job.failed) {
+        fprintf(stderr, "错误: 距离表的后向搜索失败。\n");
+        goto fail;
+    }
+    double backwardSeconds = graphNowSeconds() - phase;
+
+    // 桶: 按顶点计数排序, 按终点下标顺序填入, 因此每个桶内下标升序
+    phase = graphNowSeconds();
+    long long total = 0;
+    for (int j = 0; j < numTargets; ++j) {
+        total += job.numHits[j];
+        for (int h = 0; h < job.numHits[j]; ++h) bucketOffsets[job.hits[j][h].id + 1]++;
+    }
+    if (total > 0x7FFFFFFF) {
+        fprintf(stderr, "错误: 桶项过多 (%lld)。\n", total);
+        goto fail;
+    }
+    for (int v = 1; v <= V + 1; ++v) bucketOffsets[v] += bucketOffsets[v - 1];
+    buckets = (BucketEntry*)malloc((total > 0 ? total : 1) * sizeof(BucketEntry));
+    if (buckets == NULL) {
+        perror("错误: 无法为距离表分配内存");
+        goto fail;
+    }
+    for (int j = 0; j < numTargets; ++j) {
+        for (int h = 0; h < job.numHits[j]; ++h) {
+            BucketEntry* slot = &buckets[bucketOffsets[job.hits[j][h].id]++];
+            slot->id = j;
+            slot->dist = job.hits[j][h].dist;
+        }
+        free(job.hits[j]);
+        job.hits[j] = NULL;
+    }
+    // 填充时 bucketOffsets[v] 前移到了桶尾, 整体右移一位还原
+    for (int v = V + 1; v > 0; --v) bucketOffsets[v] = bucketOffsets[v - 1];
+    bucketOffsets[0] = 0;
+    double bucketSeconds = graphNowSeconds() - phase;
+
+    // 前向阶段
+    job.bucketOffsets = bucketOffsets;
+    job.buckets = buckets;
+    job.matrix = matrix;
+    BatchWorkerOps forwardOps = {tableCreateWorker, forwardRunQuery, tableDestroyWorker};
+    BatchStats batch;
+    phase = graphNowSeconds();
+    if (runBatchQueries(sourceIndices, numSources, numThreads < numSources ? numThreads : numSources,
+                        &forwardOps, &job, &batch) != 0 || job.failed) {
+        fprintf(stderr, "错误: 距离表的前向搜索失败。\n");
+        goto fail;
+    }
+    double forwardSeconds = graphNowSeconds() - phase;
+
+    if (stats != NULL) {
+        stats->backwardSeconds = backwardSeconds;
+        stats->bucketSeconds = bucketSeconds;
+        stats->forwardSeconds = forwardSeconds;
+        stats->seconds = graphNowSeconds() - start;
+        stats->bucketEntries = total;
+        stats->numSettled = job.numSettled;
+        stats->numThreads = batch.numThreads;
+    }
+    free(job.hits);
+    free(job.numHits);
+    free(bucketOffsets);
+    free(buckets);
+    free(targetIndices);
+    free(sourceIndices);
+    return matrix;
+
+fail:
+    if (job.hits != NULL) {
+        for (int j = 0; j < numTargets; ++j) free(job.hits[j]);
+    }
+    free(job.hits);
+    free(job.numHits);
+    free(bucketOffsets);
+    free(buckets);
+    free(matrix);
+    free(targetIndices);
+    free(sourceIndices);
+    return NULL;
+}
+
+// 内部函数：按文件布局计算各段偏移
+static void tableLayout(DistanceTableHeader* header) {
+    header->sourcesPos = graphFileAlignUp(sizeof(DistanceTableHeader));
+    header->targetsPos = graphFileAlignUp(header->sourcesPos + (unsigned long long)header->numSources * sizeof(int));
+    header->matrixPos = graphFileAlignUp(header->targetsPos + (unsigned long long)header->numTargets * sizeof(int));
+    header->fileSize = graphFileAlignUp(header->matrixPos +
+                               (unsigned long long)header->numSources * header->numTargets * sizeof(long long));
+}
+
+/**
+ * @brief 距离矩阵文件大小
+ */
+unsigned long long distanceTableFileSize(int numSources, int numTargets) {
+    DistanceTableHeader header;
+    memset(&header, 0, sizeof(header));
+    header.numSources = numSources;
+    header.numTargets = numTargets;
+    tableLayout(&header);
+    return header.fileSize;
+}
+
+/**
+ * @brief 写入距离矩阵文件
+ */
+int distanceTableSave(const char* filename, const int* sources, int numSources,
+                      const int* targets, int numTargets, const long long* matrix) {
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) {
+        perror("错误: 无法创建距离矩阵文件");
+        return -1;
+    }
+
+    DistanceTableHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DISTANCE_TABLE_MAGIC, sizeof(header.magic));
+    header.version = DISTANCE_TABLE_VERSION;
+    header.headerSize = sizeof(DistanceTableHeader);
+    header.numSources = numSources;
+    header.numTargets = numTargets;
+    tableLayout(&header);
+
+    unsigned long long pos = 0;
+    int status = graphWriteSection(file, &header, sizeof(header), &pos);
+    if (status == 0) status = graphWriteSection(file, sources, (size_t)numSources * sizeof(int), &pos);
+    if (status == 0) status = graphWriteSection(file, targets, (size_t)numTargets * sizeof(int), &pos);
+    if (status == 0) {
+        status = graphWriteSection(file, matrix, (size_t)numSources * numTargets * sizeof(long long), &pos);
+    }
+
+    if (fclose(file) != 0) status = -1;
+    if (status != 0) {
+        perror("错误: 写入距离矩阵文件失败");
+        return -1;
+    }
+    return 0;
+}
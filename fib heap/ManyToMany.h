@@ -0,0 +1,78 @@
+#ifndef MANY_TO_MANY_H
+#define MANY_TO_MANY_H
+
+#include "ContractionHierarchy.h"
+
+/**
+ * @brief 多对多距离表 (基于收缩层次的桶算法)
+ *
+ * 1. 后向阶段: 从每个终点 t_j 在 downward 图中做一次完整的向上搜索,
+ *    对每个确定的顶点 v 记录桶项 (j, d(v, t_j));
+ * 2. 把所有桶项按顶点做计数排序, 得到 CSR 形式的桶 (每个桶内按 j 升序);
+ * 3. 前向阶段: 从每个起点 s_i 在 upward 图中做一次完整的向上搜索,
+ *    对每个确定的顶点 v 扫描它的桶: D[i][j] = min(D[i][j], d(s_i, v) + d(v, t_j))。
+ * 两个方向的搜索都使用 stall-on-demand, 被 stall 的顶点不产生桶项, 也不扫描桶。
+ * 后向 / 前向阶段的各次搜索互相独立, 通过批量查询引擎并行执行;
+ * 前向阶段每个起点只写矩阵中属于自己的一行。
+ *
+ * 距离矩阵按行存放 (S × T), 不可达为 DIJKSTRA_INF。
+ *
+ * 矩阵文件布局 (本机字节序, 各段按64字节对齐):
+ *   [DistanceTableHeader][sources: int * S][targets: int * T][matrix: long long * S * T]
+ */
+#define DISTANCE_TABLE_MAGIC   "ADSDTABL"
+#define DISTANCE_TABLE_VERSION 1
+
+typedef struct DistanceTableHeader {
+    char magic[8];                    // DISTANCE_TABLE_MAGIC
+    unsigned int version;             // DISTANCE_TABLE_VERSION
+    unsigned int headerSize;          // sizeof(DistanceTableHeader)
+    int numSources;
+    int numTargets;
+    unsigned long long sourcesPos;    // 各段在文件中的字节偏移
+    unsigned long long targetsPos;
+    unsigned long long matrixPos;
+    unsigned long long fileSize;
+} DistanceTableHeader;
+
+/**
+ * @brief 一次多对多计算的统计
+ */
+typedef struct ManyToManyStats {
+    double backwardSeconds;     // 后向搜索 (并行)
+    double bucketSeconds;       // 桶的计数排序
+    double forwardSeconds;      // 前向搜索 + 扫描桶 (并行)
+    double seconds;             // 总耗时
+    long long bucketEntries;    // 桶项总数
+    long long numSettled;       // 两个阶段共确定的顶点数
+    int numThreads;             // 使用的线程数
+} ManyToManyStats;
+
+/**
+ * @brief 计算 S × T 距离矩阵
+ *
+ * @param ch 收缩层次
+ * @param sources 起点数组 (原ID)
+ * @param numSources 起点数
+ * @param targets 终点数组 (原ID)
+ * @param numTargets 终点数
+ * @param numThreads 线程数 (<= 0 表示 1)
+ * @param stats 输出统计, 可为 NULL
+ * @return 按行存放的 numSources * numTargets 矩阵 (调用者 free), 失败则返回 NULL
+ */
+long long* manyToManyTable(const ContractionHierarchy* ch, const int* sources, int numSources,
+                           const int* targets, int numTargets, int numThreads, ManyToManyStats* stats);
+
+/**
+ * @brief 写入距离矩阵文件
+ * @return 0 成功, -1 失败
+ */
+int distanceTableSave(const char* filename, const int* sources, int numSources,
+                      const int* targets, int numTargets, const long long* matrix);
+
+/**
+ * @brief 距离矩阵文件大小 (字节)
+ */
+unsigned long long distanceTableFileSize(int numSources, int numTargets);
+
+#endif // MANY_TO_MANY_H
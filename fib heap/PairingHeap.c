@@ -0,0 +1,163 @@
+#include "PairingHeap.h"
+
+/**
+ * @brief 创建配对堆
+ */
+PairingHeap* createPairingHeap(int capacity) {
+    PairingHeap* H = (PairingHeap*)malloc(sizeof(PairingHeap));
+    if (H == NULL) {
+        perror("错误: 无法为配对堆分配内存");
+        return NULL;
+    }
+    H->nodes = (PairingHeapNode*)malloc(capacity * sizeof(PairingHeapNode));
+    if (H->nodes == NULL) {
+        perror("错误: 无法为配对堆节点数组分配内存");
+        free(H);
+        return NULL;
+    }
+    H->root = PAIRING_NIL;
+    H->numNodes = 0;
+    H->capacity = capacity;
+
+    // 所有节点初始不在堆中, 只在创建时做一次
+    for (int i = 0; i < capacity; i++) {
+        H->nodes[i].prev = PAIRING_DETACHED;
+    }
+    return H;
+}
+
+/**
+ * @brief 销毁堆
+ */
+void pairingHeapDestroy(PairingHeap* H) {
+    if (H == NULL) return;
+    free(H->nodes);
+    free(H);
+}
+
+/**
+ * @brief 清空堆
+ */
+void pairingHeapReset(PairingHeap* H) {
+    PairingHeapNode* nodes = H->nodes;
+    // 工作链表经 sibling 串联: 取出一个节点, 把它的孩子链接到链表头部
+    int work = H->root;
+    while (work != PAIRING_NIL) {
+        int x = work;
+        work = nodes[x].sibling;
+        nodes[x].prev = PAIRING_DETACHED;
+        int c = nodes[x].child;
+        if (c != PAIRING_NIL) {
+            int tail = c;
+            while (nodes[tail].sibling != PAIRING_NIL) tail = nodes[tail].sibling;
+            nodes[tail].sibling = work;
+            work = c;
+        }
+    }
+    H->root = PAIRING_NIL;
+    H->numNodes = 0;
+}
+
+// 内部函数: 合并两棵树, 键较大的根成为另一个根的最左孩子; 返回新根
+// (新根的 sibling / prev 由调用者负责)
+static inline int _pairingHeapMeld(PairingHeapNode* nodes, int a, int b) {
+    if (nodes[b].key < nodes[a].key) {
+        int t = a; a = b; b = t;
+    }
+    int c = nodes[a].child;
+    nodes[b].sibling = c;
+    if (c != PAIRING_NIL) nodes[c].prev = b;
+    nodes[b].prev = a;
+    nodes[a].child = b;
+    return a;
+}
+
+// 内部函数: 把一棵独立的树并入根
+static inline void _pairingHeapMeldRoot(PairingHeap* H, int x) {
+    PairingHeapNode* nodes = H->nodes;
+    int r = (H->root == PAIRING_NIL) ? x : _pairingHeapMeld(nodes, H->root, x);
+    nodes[r].sibling = PAIRING_NIL;
+    nodes[r].prev = PAIRING_NIL;
+    H->root = r;
+}
+
+/**
+ * @brief 插入一个顶点
+ */
+void pairingHeapInsert(PairingHeap* H, long long key, int value) {
+    PairingHeapNode* x = &H->nodes[value];
+    x->key = key;
+    x->child = PAIRING_NIL;
+    x->sibling = PAIRING_NIL;
+    x->prev = PAIRING_NIL;
+    _pairingHeapMeldRoot(H, value);
+    H->numNodes++;
+}
+
+/**
+ * @brief 提取最小键的顶点 (两趟合并)
+ */
+int pairingHeapExtractMin(PairingHeap* H) {
+    if (H->root == PAIRING_NIL) {
+        fprintf(stderr, "错误: 试图从空堆中提取。\n");
+        return -1;
+    }
+    PairingHeapNode* nodes = H->nodes;
+    int minValue = H->root;
+    int c = nodes[minValue].child;
+    nodes[minValue].prev = PAIRING_DETACHED; // 标记为不在堆中
+    H->numNodes--;
+
+    // 第一趟: 从左到右两两合并, 结果经 sibling 逆序串成链表
+    int pairs = PAIRING_NIL;
+    while (c != PAIRING_NIL) {
+        int a = c;
+        int b = nodes[a].sibling;
+        int m;
+        if (b == PAIRING_NIL) {
+            c = PAIRING_NIL;
+            m = a;
+        } else {
+            c = nodes[b].sibling;
+            m = _pairingHeapMeld(nodes, a, b);
+        }
+        nodes[m].sibling = pairs;
+        pairs = m;
+    }
+
+    // 第二趟: 从右到左 (即链表顺序) 累积合并
+    int acc = pairs;
+    if (acc != PAIRING_NIL) {
+        int x = nodes[acc].sibling;
+        while (x != PAIRING_NIL) {
+            int next = nodes[x].sibling;
+            acc = _pairingHeapMeld(nodes, acc, x);
+            x = next;
+        }
+        nodes[acc].sibling = PAIRING_NIL;
+        nodes[acc].prev = PAIRING_NIL;
+    }
+    H->root = acc;
+    return minValue;
+}
+
+/**
+ * @brief 减小键值: 把以该节点为根的子树剪下, 再与根合并
+ */
+void pairingHeapDecreaseKey(PairingHeap* H, int value, long long newKey) {
+    PairingHeapNode* nodes = H->nodes;
+    PairingHeapNode* x = &nodes[value];
+    if (x->prev == PAIRING_DETACHED || x->key <= newKey) return;
+    x->key = newKey;
+    if (value == H->root) return;
+
+    // 从父节点的孩子链表中剪下
+    int p = x->prev;
+    if (nodes[p].child == value) {
+        nodes[p].child = x->sibling;
+    } else {
+        nodes[p].sibling = x->sibling;
+    }
+    if (x->sibling != PAIRING_NIL) nodes[x->sibling].prev = p;
+    _pairingHeapMeldRoot(H, value);
+}
@@ -0,0 +1,97 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h> // for LLONG_MAX
+
+// 空链接
+#define PAIRING_NIL (-1)
+// prev 取此值表示节点不在堆中
+#define PAIRING_DETACHED (-2)
+
+/**
+ * @brief 配对堆节点 (侵入式, 以顶点ID为下标存放在一个预分配数组中)
+ *
+ * 链接都是 32 位下标而不是指针, 每个节点 24 字节 (FibHeapNode 为 56 字节)。
+ * prev 指向父节点 (若自己是最左孩子) 或左兄弟; 根的 prev 为 PAIRING_NIL。
+ */
+typedef struct PairingHeapNode {
+    long long key;
+    int child;    // 最左孩子
+    int sibling;  // 右兄弟
+    int prev;     // 父节点或左兄弟, 不在堆中时为 PAIRING_DETACHED
+    int pad;      // 对齐到 24 字节
+} PairingHeapNode;
+
+/**
+ * @brief 配对堆结构体
+ *
+ * extractMin 对根的孩子做两趟合并 (从左到右两两配对, 再从右到左累积),
+ * 全部迭代实现, 不递归、不分配内存。
+ */
+typedef struct PairingHeap {
+    PairingHeapNode* nodes; // 节点数组, 长度 capacity, 下标即顶点ID
+    int root;               // 根节点, 空堆时为 PAIRING_NIL
+    int numNodes;
+    int capacity;
+} PairingHeap;
+
+/**
+ * @brief 创建配对堆
+ * @param capacity 顶点ID上限 (Dijkstra中为 V+1)
+ * @return 指向新堆的指针, 失败则返回 NULL
+ */
+PairingHeap* createPairingHeap(int capacity);
+
+/**
+ * @brief 销毁堆
+ */
+void pairingHeapDestroy(PairingHeap* H);
+
+/**
+ * @brief 清空堆 (O(剩余节点数), 空堆时 O(1))
+ */
+void pairingHeapReset(PairingHeap* H);
+
+/**
+ * @brief 插入一个顶点 (调用者保证 value 当前不在堆中)
+ * @param H 堆
+ * @param key 键 (距离)
+ * @param value 值 (顶点ID), 同时也是它的节点下标
+ */
+void pairingHeapInsert(PairingHeap* H, long long key, int value);
+
+/**
+ * @brief 提取最小键的顶点
+ * @return 顶点ID, 堆为空时返回 -1
+ */
+int pairingHeapExtractMin(PairingHeap* H);
+
+/**
+ * @brief 减小一个顶点的键值 (顶点不在堆中或新键不更小时不做任何事)
+ */
+void pairingHeapDecreaseKey(PairingHeap* H, int value, long long newKey);
+
+/**
+ * @brief 检查顶点是否在堆中
+ */
+static inline int pairingHeapContains(const PairingHeap* H, int value) {
+    return H->nodes[value].prev != PAIRING_DETACHED;
+}
+
+/**
+ * @brief 检查堆是否为空
+ */
+static inline int pairingHeapIsEmpty(const PairingHeap* H) {
+    return H->root == PAIRING_NIL;
+}
+
+/**
+ * @brief 查看最小键 (不提取), 堆为空时返回 LLONG_MAX
+ */
+static inline long long pairingHeapMinKey(const PairingHeap* H) {
+    return H->root != PAIRING_NIL ? H->nodes[H->root].key : LLONG_MAX;
+}
+
+#endif // PAIRING_HEAP_H
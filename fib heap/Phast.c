@@ -0,0 +1,302 @@
+#include "Phast.h"
+
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+// 内部函数：按新编号生成 CSR (每个顶点的边按目标编号升序, 扫描时读距离数组更连续)
+static int renumberGraph(const Graph* src, const int* newId, const int* oldId,
+                         int** offsetsOut, int** targetsOut, int** weightsOut) {
+    int V = src->numVertices;
+    int m = src->numEdges;
+    int* offsets = (int*)malloc((V + 2) * sizeof(int));
+    int* targets = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    int* weights = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    if (offsets == NULL || targets == NULL || weights == NULL) {
+        free(offsets);
+        free(targets);
+        free(weights);
+        return -1;
+    }
+
+    offsets[0] = 0;
+    offsets[1] = 0;
+    for (int a = 1; a <= V; ++a) {
+        int v = oldId[a];
+        int begin = offsets[a];
+        int count = 0;
+        for (int e = src->offsets[v]; e < src->offsets[v + 1]; ++e) {
+            // 插入排序: 每个顶点的边很少
+            int t = newId[src->targets[e]];
+            int w = src->weights[e];
+            int i = begin + count++;
+            while (i > begin && targets[i - 1] > t) {
+                targets[i] = targets[i - 1];
+                weights[i] = weights[i - 1];
+                i--;
+            }
+            targets[i] = t;
+            weights[i] = w;
+        }
+        offsets[a + 1] = begin + count;
+    }
+
+    *offsetsOut = offsets;
+    *targetsOut = targets;
+    *weightsOut = weights;
+    return 0;
+}
+
+/**
+ * @brief 创建 PHAST 引擎
+ */
+PhastEngine* createPhastEngine(const ContractionHierarchy* ch) {
+    int V = ch->numVertices;
+    PhastEngine* pe = (PhastEngine*)calloc(1, sizeof(PhastEngine));
+    if (pe == NULL) {
+        perror("错误: 无法为PHAST引擎分配内存");
+        return NULL;
+    }
+    pe->numVertices = V;
+    pe->newId = (int*)malloc((V + 1) * sizeof(int));
+    pe->oldId = (int*)calloc(V + 1, sizeof(int));
+    if (pe->newId == NULL || pe->oldId == NULL) {
+        perror("错误: 无法为PHAST引擎分配内存");
+        phastEngineDestroy(pe);
+        return NULL;
+    }
+
+    // 层次最高的顶点编号为 1, 扫描按编号升序进行
+    pe->newId[0] = 0;
+    for (int v = 1; v <= V; ++v) {
+        int r = ch->rank[v];
+        if (r < 0 || r >= V || pe->oldId[V - r] != 0) {
+            fprintf(stderr, "错误: 收缩层次的顶点顺序无效。\n");
+            phastEngineDestroy(pe);
+            return NULL;
+        }
+        pe->newId[v] = V - r;
+        pe->oldId[V - r] = v;
+    }
+
+    int* downWeights = NULL;
+    if (renumberGraph(ch->upward, pe->newId, pe->oldId, &pe->upOffsets, &pe->upTargets, &pe->upWeights) != 0 ||
+        renumberGraph(ch->downward, pe->newId, pe->oldId, &pe->downOffsets, &pe->downSources, &downWeights) != 0) {
+        perror("错误: 无法为PHAST引擎分配内存");
+        phastEngineDestroy(pe);
+        return NULL;
+    }
+    pe->downWeights = (unsigned int*)downWeights; // 权重非负, 扫描时按无符号数相加
+
+    size_t laneBytes = (size_t)(V + 1) * PHAST_LANES * sizeof(unsigned int);
+    laneBytes = (laneBytes + 63) & ~(size_t)63; // aligned_alloc 要求长度是对齐的整数倍
+    pe->heap = createBinaryHeap(V + 1);
+    pe->upDist = (unsigned int*)malloc((V + 1) * sizeof(unsigned int));
+    pe->upStamp = (unsigned int*)calloc(V + 1, sizeof(unsigned int));
+    pe->dist = (unsigned int*)malloc((V + 1) * sizeof(unsigned int));
+    pe->laneDist = (unsigned int*)aligned_alloc(64, laneBytes);
+    if (pe->heap == NULL || pe->upDist == NULL || pe->upStamp == NULL || pe->dist == NULL || pe->laneDist == NULL) {
+        perror("错误: 无法为PHAST引擎分配内存");
+        phastEngineDestroy(pe);
+        return NULL;
+    }
+    return pe;
+}
+
+/**
+ * @brief 销毁 PHAST 引擎
+ */
+void phastEngineDestroy(PhastEngine* pe) {
+    if (pe == NULL) return;
+    free(pe->newId);
+    free(pe->oldId);
+    free(pe->upOffsets);
+    free(pe->upTargets);
+    free(pe->upWeights);
+    free(pe->downOffsets);
+    free(pe->downSources);
+    free(pe->downWeights);
+    binaryHeapDestroy(pe->heap);
+    free(pe->upDist);
+    free(pe->upStamp);
+    free(pe->seeds);
+    free(pe->dist);
+    free(pe->laneDist);
+    free(pe);
+}
+
+// 内部函数：记录一个向上搜索确定的顶点
+static int pushSeed(PhastEngine* pe, int vertex, int lane, unsigned int dist) {
+    if (pe->numSeeds == pe->seedCapacity) {
+        int capacity = pe->seedCapacity > 0 ? pe->seedCapacity * 2 : 256;
+        PhastSeed* seeds = (PhastSeed*)realloc(pe->seeds, capacity * sizeof(PhastSeed));
+        if (seeds == NULL) {
+            perror("错误: 无法为PHAST引擎分配内存");
+            return -1;
+        }
+        pe->seeds = seeds;
+        pe->seedCapacity = capacity;
+    }
+    PhastSeed* s = &pe->seeds[pe->numSeeds++];
+    s->vertex = vertex;
+    s->lane = lane;
+    s->dist = dist;
+    return 0;
+}
+
+// 内部函数：按 (编号, 通道) 升序
+static int compareSeed(const void* a, const void* b) {
+    const PhastSeed* x = (const PhastSeed*)a;
+    const PhastSeed* y = (const PhastSeed*)b;
+    if (x->vertex != y->vertex) return x->vertex < y->vertex ? -1 : 1;
+    return x->lane - y->lane;
+}
+
+/**
+ * @brief 向上搜索: 在向上图中从 source (新编号) 出发的完整 Dijkstra, 确定的顶点记为种子
+ * @return 0 成功, -1 失败
+ */
+static int upwardSearch(PhastEngine* pe, int source, int lane) {
+    if (++pe->epoch == 0) {
+        memset(pe->upStamp, 0, (pe->numVertices + 1) * sizeof(unsigned int));
+        pe->epoch = 1;
+    }
+    const unsigned int epoch = pe->epoch;
+    unsigned int* dist = pe->upDist;
+    unsigned int* stamp = pe->upStamp;
+    BinaryHeap* heap = pe->heap;
+    binaryHeapReset(heap);
+    stamp[source] = epoch;
+    dist[source] = 0;
+    binaryHeapInsert(heap, 0, source);
+
+    while (!binaryHeapIsEmpty(heap)) {
+        int u = binaryHeapExtractMin(heap);
+        unsigned int du = dist[u];
+        pe->numSettledUp++;
+        if (pushSeed(pe, u, lane, du) != 0) return -1;
+        for (int e = pe->upOffsets[u]; e < pe->upOffsets[u + 1]; ++e) {
+            int v = pe->upTargets[e];
+            unsigned long long nd = (unsigned long long)du + pe->upWeights[e];
+            if (nd >= PHAST_INF) {
+                fprintf(stderr, "错误: 距离超出 PHAST 的 32 位范围。\n");
+                return -1;
+            }
+            if (stamp[v] != epoch) {
+                stamp[v] = epoch;
+                dist[v] = (unsigned int)nd;
+                binaryHeapInsert(heap, (long long)nd, v);
+            } else if (nd < dist[v]) {
+                dist[v] = (unsigned int)nd;
+                binaryHeapDecreaseKey(heap, v, (long long)nd);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 单源一对多查询
+ */
+int phastRun(PhastEngine* pe, int source) {
+    int V = pe->numVertices;
+    if (source <= 0 || source > V) {
+        fprintf(stderr, "错误: 起始节点 %d 无效。\n", source);
+        return -1;
+    }
+    pe->numSeeds = 0;
+    pe->numSettledUp = 0;
+    if (upwardSearch(pe, pe->newId[source], 0) != 0) return -1;
+    qsort(pe->seeds, pe->numSeeds, sizeof(PhastSeed), compareSeed);
+
+    // 线性扫描: 每个距离只写一次, 不需要事先整体置为无穷
+    const int* offsets = pe->downOffsets;
+    const int* sources = pe->downSources;
+    const unsigned int* weights = pe->downWeights;
+    unsigned int* d = pe->dist;
+    const PhastSeed* seed = pe->seeds;
+    const PhastSeed* seedEnd = seed + pe->numSeeds;
+    for (int v = 1; v <= V; ++v) {
+        unsigned int dv = PHAST_INF;
+        if (seed < seedEnd && seed->vertex == v) {
+            dv = seed->dist;
+            seed++;
+        }
+        int edgeEnd = offsets[v + 1];
+        for (int e = offsets[v]; e < edgeEnd; ++e) {
+            unsigned int c = d[sources[e]] + weights[e]; // d <= PHAST_INF, w <= INT_MAX: 不会回绕
+            if (c < dv) dv = c;
+        }
+        d[v] = dv;
+    }
+    return 0;
+}
+
+// 内部函数：用 v 的入边更新一个顶点的 PHAST_LANES 个距离
+static inline void relaxLanes(unsigned int* dv, const unsigned int* d, const int* sources,
+                              const unsigned int* weights, int begin, int end) {
+#if defined(__AVX2__)
+    __m256i best = _mm256_load_si256((const __m256i*)dv);
+    for (int e = begin; e < end; ++e) {
+        __m256i du = _mm256_load_si256((const __m256i*)(d + (size_t)sources[e] * PHAST_LANES));
+        best = _mm256_min_epu32(best, _mm256_add_epi32(du, _mm256_set1_epi32((int)weights[e])));
+    }
+    _mm256_store_si256((__m256i*)dv, best);
+#elif defined(__SSE4_2__)
+    __m128i lo = _mm_load_si128((const __m128i*)dv);
+    __m128i hi = _mm_load_si128((const __m128i*)(dv + 4));
+    for (int e = begin; e < end; ++e) {
+        const unsigned int* du = d + (size_t)sources[e] * PHAST_LANES;
+        __m128i w = _mm_set1_epi32((int)weights[e]);
+        lo = _mm_min_epu32(lo, _mm_add_epi32(_mm_load_si128((const __m128i*)du), w));
+        hi = _mm_min_epu32(hi, _mm_add_epi32(_mm_load_si128((const __m128i*)(du + 4)), w));
+    }
+    _mm_store_si128((__m128i*)dv, lo);
+    _mm_store_si128((__m128i*)(dv + 4), hi);
+#else
+    for (int e = begin; e < end; ++e) {
+        const unsigned int* du = d + (size_t)sources[e] * PHAST_LANES;
+        unsigned int w = weights[e];
+        for (int l = 0; l < PHAST_LANES; ++l) {
+            unsigned int c = du[l] + w;
+            if (c < dv[l]) dv[l] = c;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief 多源一对多查询
+ */
+int phastRunMulti(PhastEngine* pe, const int* sources, int count) {
+    int V = pe->numVertices;
+    if (count <= 0 || count > PHAST_LANES) {
+        fprintf(stderr, "错误: 多源查询的起点数 %d 无效 (1 .. %d)。\n", count, PHAST_LANES);
+        return -1;
+    }
+    pe->numSeeds = 0;
+    pe->numSettledUp = 0;
+    for (int l = 0; l < count; ++l) {
+        if (sources[l] <= 0 || sources[l] > V) {
+            fprintf(stderr, "错误: 起始节点 %d 无效。\n", sources[l]);
+            return -1;
+        }
+        if (upwardSearch(pe, pe->newId[sources[l]], l) != 0) return -1;
+    }
+    qsort(pe->seeds, pe->numSeeds, sizeof(PhastSeed), compareSeed);
+    pe->numLanes = count;
+
+    const int* offsets = pe->downOffsets;
+    unsigned int* d = pe->laneDist;
+    const PhastSeed* seed = pe->seeds;
+    const PhastSeed* seedEnd = seed + pe->numSeeds;
+    for (int v = 1; v <= V; ++v) {
+        unsigned int* dv = d + (size_t)v * PHAST_LANES;
+        for (int l = 0; l < PHAST_LANES; ++l) dv[l] = PHAST_INF; // 未使用的通道保持无穷
+        for (; seed < seedEnd && seed->vertex == v; ++seed) dv[seed->lane] = seed->dist;
+        relaxLanes(dv, d, pe->downSources, pe->downWeights, offsets[v], offsets[v + 1]);
+    }
+    return 0;
+}
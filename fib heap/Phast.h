@@ -0,0 +1,103 @@
+#ifndef PHAST_H
+#define PHAST_H
+
+#include "ContractionHierarchy.h"
+#include "BinaryHeap.h"
+
+/**
+ * @brief PHAST: 基于收缩层次的一对多最短路
+ *
+ * 1. 从起点在向上图中做一次 (很小的) Dijkstra;
+ * 2. 按层次从高到低线性扫描所有顶点: d(v) = min(向上搜索的结果, min_{u→v, u 更高} d(u) + w)。
+ * 扫描时顶点按层次重新编号 (层次最高的编号为 1), 于是扫描就是对距离数组和入边数组的顺序遍历,
+ * 入边的起点编号都小于 v, 已经算好; 没有堆, 也没有随机的顶点访问顺序。
+ *
+ * 多源模式每个顶点存放 PHAST_LANES 个 32 位距离, 一次扫描同时计算 PHAST_LANES 个起点
+ * (AVX2 / SSE4.1 按向量取最小, 否则退回标量循环)。
+ * 距离以 32 位无符号数存储, 最短距离必须小于 PHAST_INF。
+ */
+#define PHAST_LANES 8
+#define PHAST_INF   0x7FFFFFFFu
+
+/**
+ * @brief 向上搜索确定的顶点 (扫描前按编号排序, 扫描到该顶点时作为初值)
+ */
+typedef struct PhastSeed {
+    int vertex;            // 新编号
+    int lane;
+    unsigned int dist;
+} PhastSeed;
+
+typedef struct PhastEngine {
+    int numVertices;
+    int* newId;                    // 原ID → 新编号 (1..V, 层次最高的为 1)
+    int* oldId;                    // 新编号 → 原ID
+    // --- 按新编号存放的向上图 ---
+    int* upOffsets;
+    int* upTargets;
+    int* upWeights;
+    // --- 按新编号存放的扫描图: 顶点 v 的入边 (u, w), u < v, 按 u 升序 ---
+    int* downOffsets;
+    int* downSources;
+    unsigned int* downWeights;
+    // --- 向上搜索状态 ---
+    BinaryHeap* heap;
+    unsigned int* upDist;
+    unsigned int* upStamp;
+    unsigned int epoch;
+    PhastSeed* seeds;
+    int numSeeds;
+    int seedCapacity;
+    // --- 结果 ---
+    unsigned int* dist;            // 单源: 长度 V+1, 按新编号
+    unsigned int* laneDist;        // 多源: 长度 (V+1) * PHAST_LANES, 按新编号, 64 字节对齐
+    int numLanes;                  // 最近一次多源扫描的起点数
+    int numSettledUp;              // 最近一次查询向上搜索确定的顶点数 (多源时为总和)
+} PhastEngine;
+
+/**
+ * @brief 由收缩层次创建 PHAST 引擎 (按层次重新编号, O(V + E))
+ * @param ch 收缩层次 (创建后不再引用)
+ * @return 引擎, 失败则返回 NULL
+ */
+PhastEngine* createPhastEngine(const ContractionHierarchy* ch);
+
+/**
+ * @brief 销毁 PHAST 引擎
+ */
+void phastEngineDestroy(PhastEngine* pe);
+
+/**
+ * @brief 单源一对多查询
+ * @param source 起点 (原ID)
+ * @return 0 成功, -1 起点无效或距离超出 32 位范围
+ */
+int phastRun(PhastEngine* pe, int source);
+
+/**
+ * @brief 多源一对多查询: 一次扫描计算最多 PHAST_LANES 个起点
+ * @param sources 起点 (原ID)
+ * @param count 起点数 (1 .. PHAST_LANES)
+ * @return 0 成功, -1 失败
+ */
+int phastRunMulti(PhastEngine* pe, const int* sources, int count);
+
+/**
+ * @brief 单源查询后读取到 v (原ID) 的距离
+ * @return 距离, 不可达时为 DIJKSTRA_INF
+ */
+static inline long long phastGetDist(const PhastEngine* pe, int v) {
+    unsigned int d = pe->dist[pe->newId[v]];
+    return d >= PHAST_INF ? DIJKSTRA_INF : (long long)d;
+}
+
+/**
+ * @brief 多源查询后读取第 lane 个起点到 v (原ID) 的距离
+ * @return 距离, 不可达时为 DIJKSTRA_INF
+ */
+static inline long long phastGetLaneDist(const PhastEngine* pe, int lane, int v) {
+    unsigned int d = pe->laneDist[(size_t)pe->newId[v] * PHAST_LANES + lane];
+    return d >= PHAST_INF ? DIJKSTRA_INF : (long long)d;
+}
+
+#endif // PHAST_H
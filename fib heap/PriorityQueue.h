@@ -0,0 +1,47 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <string.h>
+
+/**
+ * @brief 可供 Dijkstra 内核选择的优先队列
+ *
+ * 每种队列通过一组以顶点ID为句柄的适配函数接入各内核模板, 得到各自完全内联的特化内核。
+ * 新增队列时除了这里的枚举值和名称, 只需在 DijkstraKernel.h 的 DIJKSTRA_QUEUE_LIST 中加一行。
+ */
+typedef enum PriorityQueueKind {
+    PQ_FIBONACCI = 0,   // 斐波那契堆 (FibonacciHeap.h)
+    PQ_BINARY,          // 带位置索引的二叉堆 (BinaryHeap.h)
+    PQ_RADIX,           // 基数堆, 要求键单调不减 (RadixHeap.h)
+    PQ_PAIRING,         // 以下标链接的配对堆 (PairingHeap.h)
+    PQ_DARY,            // 缓存对齐的 d 叉堆, d 编译时选择 (DaryHeap.h)
+    PQ_FIB_INDEXED,     // 以下标链接的斐波那契堆 (IndexedFibHeap.h)
+    PQ_KIND_COUNT
+} PriorityQueueKind;
+
+// 命令行名称与显示名称, 按 PriorityQueueKind 顺序排列
+static const char* const PQ_KIND_KEYS[PQ_KIND_COUNT] = { "fib", "binary", "radix", "pairing", "dary", "fibidx" };
+static const char* const PQ_KIND_NAMES[PQ_KIND_COUNT] = { "Fibonacci Heap", "Binary Heap", "Radix Heap", "Pairing Heap", "D-ary Heap", "Indexed Fib Heap" };
+
+/**
+ * @brief 队列的显示名称 (用于输出)
+ */
+static inline const char* priorityQueueName(PriorityQueueKind kind) {
+    return (kind >= 0 && kind < PQ_KIND_COUNT) ? PQ_KIND_NAMES[kind] : "Unknown";
+}
+
+/**
+ * @brief 按命令行名称查找队列
+ * @return 0 成功, -1 名称未知
+ */
+static inline int priorityQueueParse(const char* key, PriorityQueueKind* kind) {
+    for (int i = 0; i < PQ_KIND_COUNT; ++i) {
+        if (strcmp(key, PQ_KIND_KEYS[i]) == 0) {
+            *kind = (PriorityQueueKind)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+#endif // PRIORITY_QUEUE_H
@@ -0,0 +1,182 @@
+#include "RadixHeap.h"
+
+// 桶的初始容量
+#define RADIX_HEAP_MIN_BUCKET 64
+
+/**
+ * @brief 创建基数堆
+ */
+RadixHeap* createRadixHeap(int capacity) {
+    RadixHeap* H = (RadixHeap*)calloc(1, sizeof(RadixHeap));
+    if (H == NULL) {
+        perror("错误: 无法为基数堆分配内存");
+        return NULL;
+    }
+    H->key = (long long*)malloc(capacity * sizeof(long long));
+    H->bucketOf = (signed char*)malloc(capacity * sizeof(signed char));
+    H->slot = (int*)malloc(capacity * sizeof(int));
+    H->capacity = capacity;
+    if (H->key == NULL || H->bucketOf == NULL || H->slot == NULL) {
+        perror("错误: 无法为基数堆数组分配内存");
+        radixHeapDestroy(H);
+        return NULL;
+    }
+
+    // 所有顶点初始不在堆中, 只在创建时做一次
+    for (int i = 0; i < capacity; i++) {
+        H->bucketOf[i] = -1;
+    }
+    return H;
+}
+
+/**
+ * @brief 销毁堆
+ */
+void radixHeapDestroy(RadixHeap* H) {
+    if (H == NULL) return;
+    for (int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        free(H->buckets[b]);
+    }
+    free(H->key);
+    free(H->bucketOf);
+    free(H->slot);
+    free(H);
+}
+
+/**
+ * @brief 清空堆
+ */
+void radixHeapReset(RadixHeap* H) {
+    for (int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        for (int i = 0; i < H->bucketSize[b]; i++) {
+            H->bucketOf[H->buckets[b][i]] = -1;
+        }
+        H->bucketSize[b] = 0;
+    }
+    H->nonEmpty = 0;
+    H->last = 0;
+    H->size = 0;
+}
+
+// 内部函数: 键应放入的桶 (与 last 的最高不同位)
+static inline int _radixHeapBucket(long long key, long long last) {
+    unsigned long long diff = (unsigned long long)key ^ (unsigned long long)last;
+    return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+}
+
+// 内部函数: 保证桶 b 至少能容纳 need 个顶点 (容量按倍数增长)
+static int _radixHeapReserve(RadixHeap* H, int b, int need) {
+    if (need <= H->bucketCap[b]) return 0;
+    int newCap = H->bucketCap[b] > 0 ? H->bucketCap[b] : RADIX_HEAP_MIN_BUCKET;
+    while (newCap < need) newCap *= 2;
+    int* grown = (int*)realloc(H->buckets[b], newCap * sizeof(int));
+    if (grown == NULL) {
+        perror("错误: 无法扩展基数堆的桶");
+        return -1;
+    }
+    H->buckets[b] = grown;
+    H->bucketCap[b] = newCap;
+    return 0;
+}
+
+// 内部函数: 把顶点追加到桶 b
+static int _radixHeapPush(RadixHeap* H, int b, int value) {
+    if (_radixHeapReserve(H, b, H->bucketSize[b] + 1) != 0) return -1;
+    int idx = H->bucketSize[b]++;
+    H->buckets[b][idx] = value;
+    H->bucketOf[value] = (signed char)b;
+    H->slot[value] = idx;
+    if (b > 0) H->nonEmpty |= 1ULL << (b - 1);
+    return 0;
+}
+
+// 内部函数: 从顶点所在的桶中删除 (与桶尾交换, O(1))
+static void _radixHeapRemove(RadixHeap* H, int value) {
+    int b = H->bucketOf[value];
+    int idx = H->slot[value];
+    int tail = H->buckets[b][--H->bucketSize[b]];
+    H->buckets[b][idx] = tail;
+    H->slot[tail] = idx;
+    H->bucketOf[value] = -1;
+    if (b > 0 && H->bucketSize[b] == 0) H->nonEmpty &= ~(1ULL << (b - 1));
+}
+
+/**
+ * @brief 插入顶点
+ */
+int radixHeapInsert(RadixHeap* H, long long key, int value) {
+    H->key[value] = key;
+    if (_radixHeapPush(H, _radixHeapBucket(key, H->last), value) != 0) return -1;
+    H->size++;
+    return 0;
+}
+
+// 内部函数: 桶 0 为空时, 以第一个非空桶中的最小键作为新的 last 并重新分配该桶
+static int _radixHeapRefill(RadixHeap* H) {
+    if (H->bucketSize[0] > 0) return 0;
+
+    int b = __builtin_ctzll(H->nonEmpty) + 1;
+    int* items = H->buckets[b];
+    int count = H->bucketSize[b];
+    long long newLast = H->key[items[0]];
+    for (int i = 1; i < count; i++) {
+        if (H->key[items[i]] < newLast) newLast = H->key[items[i]];
+    }
+
+    // 先为各目标桶预留空间: 分配失败时堆保持原状, 不会丢失桶 b 中的顶点
+    int need[RADIX_HEAP_BUCKETS] = {0};
+    for (int i = 0; i < count; i++) {
+        need[_radixHeapBucket(H->key[items[i]], newLast)]++;
+    }
+    for (int t = 0; t < b; t++) {
+        if (need[t] > 0 && _radixHeapReserve(H, t, H->bucketSize[t] + need[t]) != 0) return -1;
+    }
+    H->last = newLast;
+
+    // 重新分配: 每个元素都落入严格更低的桶, 所以遍历期间桶 b 不会被写入; 空间已预留, 不会失败
+    H->bucketSize[b] = 0;
+    H->nonEmpty &= ~(1ULL << (b - 1));
+    for (int i = 0; i < count; i++) {
+        int v = items[i];
+        _radixHeapPush(H, _radixHeapBucket(H->key[v], newLast), v);
+    }
+    return 0;
+}
+
+/**
+ * @brief 查看最小键
+ */
+long long radixHeapMinKey(RadixHeap* H) {
+    if (H->size == 0 || _radixHeapRefill(H) != 0) return LLONG_MAX;
+    return H->last;
+}
+
+/**
+ * @brief 提取最小键的顶点
+ */
+int radixHeapExtractMin(RadixHeap* H) {
+    if (H->size == 0) {
+        fprintf(stderr, "错误: 试图从空堆中提取。\n");
+        return -1;
+    }
+    if (_radixHeapRefill(H) != 0) return -1;
+
+    int minValue = H->buckets[0][--H->bucketSize[0]];
+    H->bucketOf[minValue] = -1; // 标记为不在堆中
+    H->size--;
+    return minValue;
+}
+
+/**
+ * @brief 减小键值
+ */
+void radixHeapDecreaseKey(RadixHeap* H, int value, long long newKey) {
+    if (H->bucketOf[value] < 0 || H->key[value] <= newKey) return;
+    H->key[value] = newKey;
+    int b = _radixHeapBucket(newKey, H->last);
+    if (b == H->bucketOf[value]) return; // 仍在同一个桶中
+    _radixHeapRemove(H, value);
+    if (_radixHeapPush(H, b, value) != 0) {
+        H->size--; // 无法放回: 顶点已不在堆中
+    }
+}
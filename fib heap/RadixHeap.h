@@ -0,0 +1,91 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h> // for LLONG_MAX
+
+// 桶数: 桶 0 存放键等于 last 的元素, 桶 i (1..64) 存放与 last 最高不同位为第 i-1 位的元素
+#define RADIX_HEAP_BUCKETS 65
+
+/**
+ * @brief 基数堆 (单调整数优先队列, 顶点ID即句柄)
+ *
+ * 只适用于非负整数键, 且每次插入 / 减小的键都不小于最近一次提取的键 last
+ * (Dijkstra 满足这一点)。元素按 key 与 last 的最高不同位分桶;
+ * 提取时若桶 0 为空, 找到第一个非空桶, 以其中最小键作为新的 last,
+ * 把该桶的元素重新分配到更低的桶中。每个元素一生中最多下移 64 次。
+ *
+ * decreaseKey 使用位置索引: bucketOf[v] / slot[v] 记录顶点所在的桶和桶内下标,
+ * 从原桶中 O(1) 交换删除后放入新桶。
+ */
+typedef struct RadixHeap {
+    long long* key;          // 顶点当前键, 长度 capacity
+    signed char* bucketOf;   // 顶点所在的桶, 不在堆中时为 -1
+    int* slot;               // 顶点在桶内的下标
+    int* buckets[RADIX_HEAP_BUCKETS];     // 各桶的顶点数组 (按需增长, 跨查询复用)
+    int bucketSize[RADIX_HEAP_BUCKETS];
+    int bucketCap[RADIX_HEAP_BUCKETS];
+    unsigned long long nonEmpty;          // 桶 1..64 是否非空的位图 (第 i-1 位对应桶 i)
+    long long last;          // 最近一次提取的键
+    int size;                // 当前元素数
+    int capacity;            // 顶点ID上限 (不含)
+} RadixHeap;
+
+/**
+ * @brief 创建基数堆
+ * @param capacity 顶点ID上限 (Dijkstra中为 V+1)
+ * @return 指向新堆的指针, 失败则返回 NULL
+ */
+RadixHeap* createRadixHeap(int capacity);
+
+/**
+ * @brief 销毁堆
+ */
+void radixHeapDestroy(RadixHeap* H);
+
+/**
+ * @brief 清空堆并把 last 置 0 (O(size), 桶的内存保留)
+ */
+void radixHeapReset(RadixHeap* H);
+
+/**
+ * @brief 插入顶点 (调用者保证 value 不在堆中, 且 key >= last)
+ * @return 0 成功, -1 内存不足
+ */
+int radixHeapInsert(RadixHeap* H, long long key, int value);
+
+/**
+ * @brief 提取最小键的顶点
+ * @return 顶点ID, 堆为空时返回 -1
+ */
+int radixHeapExtractMin(RadixHeap* H);
+
+/**
+ * @brief 查看最小键 (不提取)
+ *
+ * 桶 0 为空时会先做一次与 extractMin 相同的重新分配, 所以不是只读操作。
+ * @return 最小键, 堆为空时返回 LLONG_MAX
+ */
+long long radixHeapMinKey(RadixHeap* H);
+
+/**
+ * @brief 减小堆中顶点的键值 (newKey >= last; 顶点不在堆中时不做任何事)
+ */
+void radixHeapDecreaseKey(RadixHeap* H, int value, long long newKey);
+
+/**
+ * @brief 检查顶点是否在堆中
+ */
+static inline int radixHeapContains(const RadixHeap* H, int value) {
+    return H->bucketOf[value] >= 0;
+}
+
+/**
+ * @brief 检查堆是否为空
+ */
+static inline int radixHeapIsEmpty(const RadixHeap* H) {
+    return H->size == 0;
+}
+
+#endif // RADIX_HEAP_H
@@ -0,0 +1,265 @@
+#include "VertexOrder.h"
+
+#include <string.h>
+
+// 命令行名称与显示名称, 按 VertexOrder 顺序排列
+static const char* const VERTEX_ORDER_KEYS[VERTEX_ORDER_COUNT] = { "bfs", "dfs", "hilbert" };
+static const char* const VERTEX_ORDER_NAMES[VERTEX_ORDER_COUNT] = { "BFS", "DFS", "Hilbert" };
+
+/**
+ * @brief 顺序的显示名称
+ */
+const char* vertexOrderName(VertexOrder order) {
+    return (order >= 0 && order < VERTEX_ORDER_COUNT) ? VERTEX_ORDER_NAMES[order] : "Unknown";
+}
+
+/**
+ * @brief 按命令行名称查找顺序
+ */
+int vertexOrderParse(const char* name, VertexOrder* order) {
+    for (int i = 0; i < VERTEX_ORDER_COUNT; ++i) {
+        if (strcmp(name, VERTEX_ORDER_KEYS[i]) == 0) {
+            *order = (VertexOrder)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// 内部函数：按访问顺序追加一个顶点
+static inline void visit(VertexPermutation* p, int* next, int v) {
+    p->newId[v] = ++*next;
+    p->oldId[*next] = v;
+}
+
+// 内部函数：BFS 访问顺序 (oldId 的已填部分兼作队列)
+static void orderBfs(const Graph* g, VertexPermutation* p) {
+    int V = g->numVertices;
+    int next = 0;
+    for (int root = 1; root <= V; ++root) {
+        if (p->newId[root] != 0) continue;
+        int head = next + 1;
+        visit(p, &next, root);
+        while (head <= next) {
+            int u = p->oldId[head++];
+            for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+                int v = g->targets[e];
+                if (p->newId[v] == 0) visit(p, &next, v);
+            }
+        }
+    }
+}
+
+// 内部函数：DFS 前序 (显式栈, 每层记录下一条要看的边)
+static int orderDfs(const Graph* g, VertexPermutation* p) {
+    int V = g->numVertices;
+    int* stackVertex = (int*)malloc((V + 1) * sizeof(int));
+    int* stackEdge = (int*)malloc((V + 1) * sizeof(int));
+    if (stackVertex == NULL || stackEdge == NULL) {
+        free(stackVertex);
+        free(stackEdge);
+        return -1;
+    }
+    int next = 0;
+    for (int root = 1; root <= V; ++root) {
+        if (p->newId[root] != 0) continue;
+        int top = 0;
+        visit(p, &next, root);
+        stackVertex[0] = root;
+        stackEdge[0] = g->offsets[root];
+        while (top >= 0) {
+            int u = stackVertex[top];
+            if (stackEdge[top] == g->offsets[u + 1]) {
+                top--;
+                continue;
+            }
+            int v = g->targets[stackEdge[top]++];
+            if (p->newId[v] != 0) continue;
+            visit(p, &next, v);
+            top++;
+            stackVertex[top] = v;
+            stackEdge[top] = g->offsets[v];
+        }
+    }
+    free(stackVertex);
+    free(stackEdge);
+    return 0;
+}
+
+// 内部函数：(x, y) 在 2^16 × 2^16 网格上的 Hilbert 曲线下标
+static unsigned long long hilbertIndex(unsigned int x, unsigned int y) {
+    unsigned long long d = 0;
+    for (unsigned int s = 1u << 15; s > 0; s >>= 1) {
+        unsigned int rx = (x & s) ? 1 : 0;
+        unsigned int ry = (y & s) ? 1 : 0;
+        d += (unsigned long long)s * s * ((3 * rx) ^ ry);
+        // 旋转象限, 使子曲线的起点和终点与父曲线相接
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            unsigned int t = x;
+            x = y;
+            y = t;
+        }
+        x &= s - 1;
+        y &= s - 1;
+    }
+    return d;
+}
+
+typedef struct HilbertKey {
+    unsigned long long key;
+    int vertex;
+} HilbertKey;
+
+static int compareHilbertKey(const void* a, const void* b) {
+    const HilbertKey* x = (const HilbertKey*)a;
+    const HilbertKey* y = (const HilbertKey*)b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return x->vertex - y->vertex;
+}
+
+// 内部函数：按坐标的 Hilbert 曲线顺序
+static int orderHilbert(const Graph* g, VertexPermutation* p) {
+    int V = g->numVertices;
+    long long minX = g->coords[1].x, maxX = minX, minY = g->coords[1].y, maxY = minY;
+    for (int v = 2; v <= V; ++v) {
+        if (g->coords[v].x < minX) minX = g->coords[v].x;
+        if (g->coords[v].x > maxX) maxX = g->coords[v].x;
+        if (g->coords[v].y < minY) minY = g->coords[v].y;
+        if (g->coords[v].y > maxY) maxY = g->coords[v].y;
+    }
+    // 两个方向用同一个比例, 保持形状
+    long long extent = (maxX - minX > maxY - minY ? maxX - minX : maxY - minY) + 1;
+
+    HilbertKey* keys = (HilbertKey*)malloc(V * sizeof(HilbertKey));
+    if (keys == NULL) return -1;
+    for (int v = 1; v <= V; ++v) {
+        unsigned int x = (unsigned int)((g->coords[v].x - minX) * 65536 / extent);
+        unsigned int y = (unsigned int)((g->coords[v].y - minY) * 65536 / extent);
+        keys[v - 1].key = hilbertIndex(x, y);
+        keys[v - 1].vertex = v;
+    }
+    qsort(keys, V, sizeof(HilbertKey), compareHilbertKey);
+    int next = 0;
+    for (int i = 0; i < V; ++i) visit(p, &next, keys[i].vertex);
+    free(keys);
+    return 0;
+}
+
+/**
+ * @brief 计算顶点顺序
+ */
+VertexPermutation* computeVertexOrder(const Graph* g, VertexOrder order) {
+    int V = g->numVertices;
+    if (order == VERTEX_ORDER_HILBERT && (g->coords == NULL || V == 0)) {
+        fprintf(stderr, "错误: Hilbert 顺序需要顶点坐标 (--co)。\n");
+        return NULL;
+    }
+    VertexPermutation* p = (VertexPermutation*)malloc(sizeof(VertexPermutation));
+    if (p == NULL) {
+        perror("错误: 无法为顶点映射分配内存");
+        return NULL;
+    }
+    p->numVertices = V;
+    p->order = order;
+    p->newId = (int*)calloc(V + 1, sizeof(int));   // 0 表示尚未访问
+    p->oldId = (int*)calloc(V + 1, sizeof(int));
+    if (p->newId == NULL || p->oldId == NULL) {
+        perror("错误: 无法为顶点映射分配内存");
+        vertexPermutationDestroy(p);
+        return NULL;
+    }
+
+    int status = 0;
+    switch (order) {
+        case VERTEX_ORDER_BFS:     orderBfs(g, p); break;
+        case VERTEX_ORDER_DFS:     status = orderDfs(g, p); break;
+        case VERTEX_ORDER_HILBERT: status = orderHilbert(g, p); break;
+        default:                   status = -1; break;
+    }
+    if (status != 0) {
+        perror("错误: 无法计算顶点顺序");
+        vertexPermutationDestroy(p);
+        return NULL;
+    }
+    return p;
+}
+
+/**
+ * @brief 销毁映射
+ */
+void vertexPermutationDestroy(VertexPermutation* p) {
+    if (p == NULL) return;
+    free(p->newId);
+    free(p->oldId);
+    free(p);
+}
+
+/**
+ * @brief 按映射重新编号, 生成新图
+ */
+Graph* graphPermute(const Graph* g, const VertexPermutation* p) {
+    int V = g->numVertices;
+    int m = g->numEdges;
+    Graph* h = (Graph*)calloc(1, sizeof(Graph));
+    if (h == NULL) {
+        perror("错误: 无法为图分配内存");
+        return NULL;
+    }
+    h->numVertices = V;
+    h->numEdges = m;
+    h->offsets = (int*)malloc((V + 2) * sizeof(int));
+    h->targets = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    h->weights = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    if (g->coords != NULL) h->coords = (GraphCoord*)malloc((V + 1) * sizeof(GraphCoord));
+    if (h->offsets == NULL || h->targets == NULL || h->weights == NULL ||
+        (g->coords != NULL && h->coords == NULL)) {
+        perror("错误: 无法为CSR数组分配内存");
+        graphDestroy(h);
+        return NULL;
+    }
+
+    h->offsets[0] = 0;
+    h->offsets[1] = 0;
+    for (int a = 1; a <= V; ++a) {
+        int u = p->oldId[a];
+        int begin = h->offsets[a];
+        int count = 0;
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            // 插入排序: 道路图的出度很小
+            int t = p->newId[g->targets[e]];
+            int w = g->weights[e];
+            int i = begin + count++;
+            while (i > begin && h->targets[i - 1] > t) {
+                h->targets[i] = h->targets[i - 1];
+                h->weights[i] = h->weights[i - 1];
+                i--;
+            }
+            h->targets[i] = t;
+            h->weights[i] = w;
+        }
+        h->offsets[a + 1] = begin + count;
+        if (h->coords != NULL) h->coords[a] = g->coords[u];
+    }
+    if (h->coords != NULL) h->coords[0] = g->coords[0];
+    return h;
+}
+
+/**
+ * @brief 边的平均ID跨度
+ */
+double vertexOrderEdgeSpan(const Graph* g, const VertexPermutation* p) {
+    if (g->numEdges == 0) return 0.0;
+    double total = 0.0;
+    for (int u = 1; u <= g->numVertices; ++u) {
+        int a = p != NULL ? p->newId[u] : u;
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            int b = p != NULL ? p->newId[g->targets[e]] : g->targets[e];
+            total += a > b ? a - b : b - a;
+        }
+    }
+    return total / g->numEdges;
+}
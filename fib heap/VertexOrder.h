@@ -0,0 +1,81 @@
+#ifndef VERTEX_ORDER_H
+#define VERTEX_ORDER_H
+
+#include "Graph.h"
+
+/**
+ * @brief 顶点重新编号 (改善缓存局部性)
+ *
+ * DIMACS 的顶点ID与空间位置无关, 松弛时 state[v] 的访问几乎总是落在不同的缓存行。
+ * 按 BFS / DFS 访问顺序或 Hilbert 曲线 (需要坐标) 重新编号后, 相邻顶点的ID相近,
+ * 它们的查询状态和邻接表也就在内存中相邻。
+ *
+ * 重新编号得到一张新的 CSR 图 (每个顶点的边按新的目标ID升序) 和双向映射:
+ * 查询前用 vertexToNew 换算起点, 读取结果时用 vertexToNew 换算要读的顶点, 对外仍使用原ID。
+ */
+typedef enum VertexOrder {
+    VERTEX_ORDER_BFS = 0,     // 广度优先访问顺序
+    VERTEX_ORDER_DFS,         // 深度优先前序
+    VERTEX_ORDER_HILBERT,     // 坐标的 Hilbert 曲线顺序 (需要 g->coords)
+    VERTEX_ORDER_COUNT
+} VertexOrder;
+
+/**
+ * @brief 原ID ↔ 新ID 的双向映射 (两个数组长度均为 V+1, 下标0不使用)
+ */
+typedef struct VertexPermutation {
+    int numVertices;
+    VertexOrder order;
+    int* newId;               // 原ID → 新ID
+    int* oldId;               // 新ID → 原ID
+} VertexPermutation;
+
+/**
+ * @brief 计算顶点顺序
+ *
+ * BFS / DFS 沿出边遍历, 从ID最小的未访问顶点开始, 一棵树结束后从下一个未访问顶点继续,
+ * 因此不连通的图也会覆盖所有顶点。
+ *
+ * @param g 图
+ * @param order 顺序
+ * @return 映射, 失败 (例如 Hilbert 顺序但没有坐标) 则返回 NULL
+ */
+VertexPermutation* computeVertexOrder(const Graph* g, VertexOrder order);
+
+/**
+ * @brief 销毁映射
+ */
+void vertexPermutationDestroy(VertexPermutation* p);
+
+/**
+ * @brief 按映射重新编号, 生成新图 (坐标一并重排, 不复制反向图)
+ * @return 新图 (调用者 graphDestroy), 失败则返回 NULL
+ */
+Graph* graphPermute(const Graph* g, const VertexPermutation* p);
+
+/**
+ * @brief 边的平均ID跨度 |id(u) - id(v)| (局部性的简单度量, 越小越好)
+ * @param p 映射, 为 NULL 时按原ID计算
+ */
+double vertexOrderEdgeSpan(const Graph* g, const VertexPermutation* p);
+
+/**
+ * @brief 顺序的显示名称
+ */
+const char* vertexOrderName(VertexOrder order);
+
+/**
+ * @brief 解析名称 ("bfs" / "dfs" / "hilbert")
+ * @return 0 成功, -1 未知名称
+ */
+int vertexOrderParse(const char* name, VertexOrder* order);
+
+static inline int vertexToNew(const VertexPermutation* p, int v) {
+    return p->newId[v];
+}
+
+static inline int vertexToOld(const VertexPermutation* p, int v) {
+    return p->oldId[v];
+}
+
+#endif // VERTEX_ORDER_H
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "Landmarks.h"
+
+/**
+ * @brief 主程序：ALT 地标预处理
+ * * 用法: ./build_landmarks <graph_file> <k> <output.lmk> [--select farthest|avoid] [--threads <t>] [--heap <q>] [--seed <s>]
+ * * 选出 k 个地标, 计算所有顶点到 / 从每个地标的距离, 写入可 mmap 的地标文件。
+ * * 选点是贪心的, 前 j 个地标与只选 j 个时相同, 因此同时报告 j = 1, 2, 4, ..., k 的预处理耗时和文件大小。
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "错误: 参数数量不正确。\n");
+        fprintf(stderr, "用法: %s <graph_file> <k> <output.lmk> [--select farthest|avoid] [--threads <t>] [--heap <q>] [--seed <s>]\n", argv[0]);
+        fprintf(stderr, "  <k>: 地标数 (1 .. %d)\n", LANDMARK_MAX_COUNT);
+        fprintf(stderr, "  --select: 地标选择方法 (默认 avoid)\n");
+        fprintf(stderr, "  --threads: 并行计算反向距离的线程数 (默认为CPU数)\n");
+        fprintf(stderr, "  --heap: 一对多查询使用的优先队列 (默认 fib)\n");
+        fprintf(stderr, "  --seed: 随机种子 (默认 1)\n");
+        return 1;
+    }
+
+    const char* graph_filename = argv[1];
+    int k = atoi(argv[2]);
+    const char* output_filename = argv[3];
+    LandmarkSelection selection = LANDMARK_SELECT_AVOID;
+    int num_threads = graphDefaultThreadCount();
+    PriorityQueueKind kind = PQ_FIBONACCI;
+    unsigned int seed = 1;
+
+    for (int i = 4; i < argc; ++i) {
+        if (strcmp(argv[i], "--select") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (strcmp(name, "farthest") == 0) {
+                selection = LANDMARK_SELECT_FARTHEST;
+            } else if (strcmp(name, "avoid") == 0) {
+                selection = LANDMARK_SELECT_AVOID;
+            } else {
+                fprintf(stderr, "错误: 未知的选择方法 '%s'。\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--heap") == 0 && i + 1 < argc) {
+            if (priorityQueueParse(argv[++i], &kind) != 0) {
+                fprintf(stderr, "错误: 未知的优先队列 '%s'。\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "错误: 未知参数 '%s'。\n", argv[i]);
+            return 1;
+        }
+    }
+    if (k <= 0 || k > LANDMARK_MAX_COUNT) {
+        fprintf(stderr, "错误: 地标数必须在 1 到 %d 之间。\n", LANDMARK_MAX_COUNT);
+        return 1;
+    }
+    if (num_threads <= 0) num_threads = 1;
+
+    Graph* g = loadGraph(graph_filename);
+    if (g == NULL) return 1;
+
+    printf("选择 %d 个地标 (%s, %s), 反向距离使用 %d 个线程...\n", k,
+           landmarkSelectionName(selection), priorityQueueName(kind), num_threads);
+    LandmarkBuildStats stats;
+    LandmarkSet* set = landmarkBuild(g, k, selection, kind, num_threads, seed, &stats);
+    if (set == NULL) {
+        graphDestroy(g);
+        return 1;
+    }
+    k = set->numLandmarks;
+
+    // 反向阶段每个地标一次一对多查询, 前 j 个地标的耗时按比例估计
+    printf("\n%6s %14s %14s %14s %12s\n", "k", "选点+正向(秒)", "反向(秒)", "总计(秒)", "文件(MB)");
+    for (int j = 1; j <= k; j = (j < k && j * 2 > k) ? k : j * 2) {
+        double reverse = stats.reverseSeconds * j / k;
+        printf("%6d %14.3f %14.3f %14.3f %12.2f\n", j, stats.selectSeconds[j - 1], reverse,
+               stats.selectSeconds[j - 1] + reverse,
+               (double)landmarkFileSize(g->numVertices, j) / (1024.0 * 1024.0));
+    }
+    printf("反向阶段: %d 个线程\n", stats.numThreads);
+
+    int status = landmarkSave(set, output_filename);
+    if (status == 0) {
+        printf("地标文件已写入 %s (版本 %d, %d 个地标, %.2f MB)\n", output_filename, LANDMARK_FILE_VERSION, k,
+               (double)landmarkFileSize(g->numVertices, k) / (1024.0 * 1024.0));
+    }
+
+    landmarkSetDestroy(set);
+    graphDestroy(g);
+    return status == 0 ? 0 : 1;
+}
@@ -2,28 +2,55 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "Graph.h"
+
 #define MAX_LINE_LENGTH 256 // 定义每行最大长度
 
+/**
+ * @brief 快照模式: 直接流式读取 .gr 构建CSR, 然后写入二进制快照
+ */
+static int convert_to_snapshot(const char* input_filename, const char* output_filename) {
+    Graph* g = loadGraphFromDimacs(input_filename, NULL);
+    if (g == NULL) return 1;
+
+    int status = graphSaveSnapshot(g, output_filename);
+    if (status == 0) {
+        printf("处理完成。\n");
+        printf("快照已写入 %s (版本 %d, %d 个顶点, %d 条边)\n",
+               output_filename, GRAPH_SNAPSHOT_VERSION, g->numVertices, g->numEdges);
+    }
+    graphDestroy(g);
+    return status == 0 ? 0 : 1;
+}
+
 /**
  * @brief 主程序：将 DIMACS .gr 格式文件转换为 "id1 id2 距离" 格式
- * * 用法: ./convert_format <input_file.gr> <output_file.txt>
+ * * 用法: ./convert_format [-b] <input_file.gr> <output_file>
+ * * -b: 输出二进制图快照 (测试程序可直接 mmap 加载)
  */
 int main(int argc, char* argv[]) {
     
     // --- 1. 参数检查 ---
-    // 检查命令行参数数量是否正确 (程序名 + 输入文件 + 输出文件)
-    if (argc != 3) {
+    // 检查命令行参数数量是否正确 (程序名 + [-b] + 输入文件 + 输出文件)
+    int snapshot = (argc == 4 && strcmp(argv[1], "-b") == 0);
+    if (argc != 3 && !snapshot) {
         fprintf(stderr, "错误: 参数数量不正确。\n");
-        fprintf(stderr, "用法: %s <input_file.gr> <output_file.txt>\n", argv[0]);
+        fprintf(stderr, "用法: %s [-b] <input_file.gr> <output_file>\n", argv[0]);
+        fprintf(stderr, "  -b: 输出二进制图快照而不是文本\n");
         return 1; // 返回错误码
     }
 
-    const char* input_filename = argv[1];
-    const char* output_filename = argv[2];
+    const char* input_filename = argv[argc - 2];
+    const char* output_filename = argv[argc - 1];
 
     FILE* input_file = NULL;
     FILE* output_file = NULL;
 
+    if (snapshot) {
+        printf("开始处理文件: %s\n", input_filename);
+        return convert_to_snapshot(input_filename, output_filename);
+    }
+
     // --- 2. 打开文件 ---
     // 打开原始数据文件 (输入)
     input_file = fopen(input_filename, "r");
@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "Dijkstra.h"
+#include "ContractionHierarchy.h"
+#include "ManyToMany.h"
+
+/**
+ * @brief 读取顶点ID列表 (每行一个, 空行和 # 开头的行被忽略)
+ * @return ID数组 (调用者 free), 失败则返回 NULL
+ */
+static int* readIdList(const char* filename, int* count) {
+    FILE* file = fopen(filename, "r");
+    if (file == NULL) {
+        perror("错误: 无法打开ID列表文件");
+        return NULL;
+    }
+    int capacity = 1024;
+    int n = 0;
+    int* ids = (int*)malloc(capacity * sizeof(int));
+    char line[256];
+    while (ids != NULL && fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        if (n == capacity) {
+            capacity *= 2;
+            int* grown = (int*)realloc(ids, capacity * sizeof(int));
+            if (grown == NULL) {
+                free(ids);
+                ids = NULL;
+                break;
+            }
+            ids = grown;
+        }
+        ids[n++] = atoi(line);
+    }
+    fclose(file);
+    if (ids == NULL) {
+        perror("错误: 无法为ID列表分配内存");
+        return NULL;
+    }
+    *count = n;
+    return ids;
+}
+
+/**
+ * @brief 计算一张距离表, 打印耗时, 并用逐源 Dijkstra 核对前 verify 行
+ * @return 距离矩阵 (调用者 free), 失败则返回 NULL
+ */
+static long long* runTable(const Graph* g, const ContractionHierarchy* ch, const int* sources, int numSources,
+                           const int* targets, int numTargets, int num_threads, int verify) {
+    ManyToManyStats stats;
+    long long* matrix = manyToManyTable(ch, sources, numSources, targets, numTargets, num_threads, &stats);
+    if (matrix == NULL) return NULL;
+
+    // 对照: 每个起点一次完整的 dijkstra_fib_heap, 从 O(V) 的 dist 数组里取出 T 个值
+    int rows = verify < numSources ? verify : numSources;
+    long long mismatches = 0;
+    double dijkstraSeconds = 0.0;
+    if (rows > 0) {
+        DijkstraContext* ctx = createDijkstraContext(g);
+        if (ctx == NULL) {
+            free(matrix);
+            return NULL;
+        }
+        for (int i = 0; i < rows; ++i) {
+            double start = graphNowSeconds();
+            dijkstraRun(ctx, sources[i]);
+            dijkstraSeconds += graphNowSeconds() - start;
+            for (int j = 0; j < numTargets; ++j) {
+                if (dijkstraGetDist(ctx, targets[j]) != matrix[(size_t)i * numTargets + j]) mismatches++;
+            }
+        }
+        dijkstraContextDestroy(ctx);
+    }
+
+    char size[32];
+    snprintf(size, sizeof(size), "%dx%d", numSources, numTargets);
+    printf("%-12s %10.3f %10.3f %10.3f %10.3f %12lld %12.1f", size, stats.backwardSeconds,
+           stats.bucketSeconds, stats.forwardSeconds, stats.seconds, stats.bucketEntries,
+           (double)numSources * numTargets / (stats.seconds > 0 ? stats.seconds : 1e-9) / 1e6);
+    if (rows > 0) {
+        double estimate = dijkstraSeconds / rows * numSources;
+        printf(" %14.3f %8.1fx %6lld/%lld", estimate, estimate / (stats.seconds > 0 ? stats.seconds : 1e-9),
+               mismatches, (long long)rows * numTargets);
+    }
+    printf("\n");
+    return matrix;
+}
+
+/**
+ * @brief 主程序：多对多距离表
+ * * 用法: ./distance_table <graph_file> <graph.ch> [--sources <file> --targets <file>] [--sizes <n1,n2,...>]
+ * *                        [--output <table.bin>] [--threads <t>] [--verify <rows>] [--seed <s>]
+ * * 给出 --sources / --targets 时计算这一张表; 否则对 --sizes 中的每个 n 随机选 n 个起点和 n 个终点。
+ * * 报告后向 / 建桶 / 前向各阶段耗时, 并与逐源 dijkstra_fib_heap 的估计耗时对比;
+ * * 最后一张表写入 --output 指定的二进制矩阵文件。
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "错误: 参数数量不正确。\n");
+        fprintf(stderr, "用法: %s <graph_file> <graph.ch> [--sources <file> --targets <file>] [--sizes <n1,n2,...>]\n"
+                        "       [--output <table.bin>] [--threads <t>] [--verify <rows>] [--seed <s>]\n", argv[0]);
+        fprintf(stderr, "  --sources/--targets: 起点 / 终点ID列表文件 (每行一个)\n");
+        fprintf(stderr, "  --sizes: 随机表的规模 (默认 100,500,1000,5000)\n");
+        fprintf(stderr, "  --output: 写入最后一张表的矩阵文件\n");
+        fprintf(stderr, "  --threads: 线程数 (默认为CPU数)\n");
+        fprintf(stderr, "  --verify: 用 dijkstra_fib_heap 核对的行数 (默认 3, 0 表示不核对)\n");
+        fprintf(stderr, "  --seed: 随机种子 (默认 1)\n");
+        return 1;
+    }
+
+    const char* graph_filename = argv[1];
+    const char* ch_filename = argv[2];
+    const char* sources_filename = NULL;
+    const char* targets_filename = NULL;
+    const char* sizes = "100,500,1000,5000";
+    const char* output_filename = NULL;
+    int num_threads = graphDefaultThreadCount();
+    int verify = 3;
+    unsigned int seed = 1;
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--sources") == 0 && i + 1 < argc) {
+            sources_filename = argv[++i];
+        } else if (strcmp(argv[i], "--targets") == 0 && i + 1 < argc) {
+            targets_filename = argv[++i];
+        } else if (strcmp(argv[i], "--sizes") == 0 && i + 1 < argc) {
+            sizes = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_filename = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--verify") == 0 && i + 1 < argc) {
+            verify = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "错误: 未知参数 '%s'。\n", argv[i]);
+            return 1;
+        }
+    }
+    if ((sources_filename == NULL) != (targets_filename == NULL)) {
+        fprintf(stderr, "错误: --sources 和 --targets 必须同时给出。\n");
+        return 1;
+    }
+    if (num_threads <= 0) num_threads = 1;
+
+    Graph* g = loadGraph(graph_filename);
+    if (g == NULL) return 1;
+    ContractionHierarchy* ch = chLoad(ch_filename, g);
+    if (ch == NULL) {
+        graphDestroy(g);
+        return 1;
+    }
+
+    printf("多对多距离表 (%d 个线程, 收缩层次 %s)\n\n", num_threads, ch_filename);
+    printf("%-12s %10s %10s %10s %10s %12s %12s", "S x T", "后向(秒)", "建桶(秒)", "前向(秒)",
+           "总计(秒)", "桶项", "百万项/秒");
+    if (verify > 0) printf(" %14s %9s %s", "逐源Dijkstra", "加速比", "不一致");
+    printf("\n");
+
+    int status = 0;
+    int* sources = NULL;
+    int* targets = NULL;
+    int numSources = 0;
+    int numTargets = 0;
+    long long* matrix = NULL;
+    if (sources_filename != NULL) {
+        sources = readIdList(sources_filename, &numSources);
+        targets = readIdList(targets_filename, &numTargets);
+        if (sources == NULL || targets == NULL) {
+            status = -1;
+        } else {
+            matrix = runTable(g, ch, sources, numSources, targets, numTargets, num_threads, verify);
+            if (matrix == NULL) status = -1;
+        }
+    } else {
+        srand(seed);
+        const char* p = sizes;
+        while (status == 0 && *p != '\0') {
+            int n = atoi(p);
+            if (n <= 0) {
+                fprintf(stderr, "错误: 无效的规模 '%s'。\n", p);
+                status = -1;
+                break;
+            }
+            free(sources);
+            free(targets);
+            free(matrix);
+            matrix = NULL;
+            sources = (int*)malloc(n * sizeof(int));
+            targets = (int*)malloc(n * sizeof(int));
+            if (sources == NULL || targets == NULL) {
+                perror("错误: 无法为顶点集合分配内存");
+                status = -1;
+                break;
+            }
+            for (int i = 0; i < n; ++i) {
+                sources[i] = (rand() % g->numVertices) + 1;
+                targets[i] = (rand() % g->numVertices) + 1;
+            }
+            numSources = numTargets = n;
+            matrix = runTable(g, ch, sources, n, targets, n, num_threads, verify);
+            if (matrix == NULL) status = -1;
+            while (*p != '\0' && *p != ',') p++;
+            if (*p == ',') p++;
+        }
+    }
+
+    if (status == 0 && output_filename != NULL && matrix != NULL) {
+        status = distanceTableSave(output_filename, sources, numSources, targets, numTargets, matrix);
+        if (status == 0) {
+            printf("\n%dx%d 距离矩阵已写入 %s (版本 %d, %.2f MB)\n", numSources, numTargets, output_filename,
+                   DISTANCE_TABLE_VERSION,
+                   (double)distanceTableFileSize(numSources, numTargets) / (1024.0 * 1024.0));
+        }
+    }
+
+    free(sources);
+    free(targets);
+    free(matrix);
+    chDestroy(ch);
+    graphDestroy(g);
+    return status == 0 ? 0 : 1;
+}
@@ -1,149 +1,929 @@
+#define _POSIX_C_SOURCE 200809L // pthread_barrier (DeltaStepping.h)
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>   // 用于计时 (clock) 和随机数 (srand)
+#include <time.h>   // 用于随机数种子 (srand)
 #include <limits.h> // 用于 LLONG_MAX
 
 #include "Graph.h"
-#include "FibonacciHeap.h"
+#include "Dijkstra.h"
+#include "PriorityQueue.h"
+#include "BatchQuery.h"
+#include "DeltaStepping.h"
+#include "AStar.h"
+#include "Landmarks.h"
+#include "ContractionHierarchy.h"
+#include "Phast.h"
+#include "VertexOrder.h"
+#include "CacheProbe.h"
+#include "CompressedGraph.h"
+
+// --- 批量查询回调: 每个工作线程拥有自己的查询上下文, 图只读共享 ---
+
+typedef struct WorkerConfig {
+    const Graph* g;
+    PriorityQueueKind kind;
+} WorkerConfig;
+
+static void* fibWorkerCreate(void* userData) {
+    const WorkerConfig* cfg = (const WorkerConfig*)userData;
+    return createDijkstraContextWithQueue(cfg->g, cfg->kind);
+}
+
+static void fibWorkerQuery(void* worker, int source, void* userData) {
+    (void)userData;
+    if (dijkstraRun((DijkstraContext*)worker, source) < 0) {
+        fprintf(stderr, "警告: 查询 (源: %d) 失败。\n", source);
+    }
+}
+
+static void fibWorkerDestroy(void* worker) {
+    dijkstraContextDestroy((DijkstraContext*)worker);
+}
+
+static const BatchWorkerOps FIB_WORKER_OPS = {
+    fibWorkerCreate, fibWorkerQuery, fibWorkerDestroy
+};
+
+/**
+ * @brief 用指定的优先队列执行同一批查询并打印结果
+ */
+static void runBenchmark(const Graph* g, PriorityQueueKind kind, const int* source_nodes, int n,
+                         int num_threads, int scaling) {
+    WorkerConfig cfg = { g, kind };
+    const char* name = priorityQueueName(kind);
+
+    if (scaling) {
+        // 同一批源点, 依次用 1, 2, 4, ..., num_threads 个线程执行
+        printf("\n--- 扩展性测试 (%s) ---\n", name);
+        printf("%8s %12s %12s %10s %10s %10s\n", "线程数", "耗时(秒)", "查询/秒", "加速比", "并行效率", "窃取次数");
+        double base_qps = 0.0;
+        for (int t = 1; t != 0; t = batchNextThreadCount(t, num_threads)) {
+            BatchStats stats;
+            if (runBatchQueries(source_nodes, n, t, &FIB_WORKER_OPS, &cfg, &stats) != 0) {
+                fprintf(stderr, "警告: %d 线程批量查询未全部完成。\n", t);
+            }
+            if (t == 1) base_qps = stats.queriesPerSecond;
+            double speedup = base_qps > 0 ? stats.queriesPerSecond / base_qps : 0.0;
+            printf("%8d %12.4f %12.2f %10.2f %9.1f%% %10lld\n", t, stats.seconds,
+                   stats.queriesPerSecond, speedup, speedup / t * 100.0, stats.steals);
+        }
+    } else {
+        // 每个工作线程一个查询上下文 (堆, 距离数组只分配一次)
+        BatchStats stats;
+        if (runBatchQueries(source_nodes, n, num_threads, &FIB_WORKER_OPS, &cfg, &stats) != 0) {
+            fprintf(stderr, "警告: 批量查询未全部完成。\n");
+        }
 
-// 定义无穷大
-const long long INF = LLONG_MAX;
+        printf("\n--- 性能测试结果 (%s) ---\n", name);
+        printf("线程数: %d\n", stats.numThreads);
+        printf("总共执行查询: %d\n", stats.numQueries);
+        printf("总耗时: %.4f 秒\n", stats.seconds);
+        printf("平均每次查询耗时: %.4f 毫秒\n", (stats.seconds / n) * 1000.0);
+        printf("总吞吐量: %.2f 查询/秒\n", stats.queriesPerSecond);
+    }
+}
 
 /**
- * @brief 使用斐波那契堆实现Dijkstra算法 (C语言版)
+ * @brief 单个查询内部并行的 delta-stepping: 报告每次查询的延迟, 并逐点与 Dijkstra 比对
  *
- * @param g 图对象
- * @param startNode 起始顶点ID
- * @return long long* 数组, 包含从startNode到所有其他节点的最短距离
- * 调用者必须手动 free() 此数组
+ * scaling 时依次用 1, 2, 4, ..., num_threads 个线程。每个查询的参考距离只算一次,
+ * 各线程数的结果都与它比对; 比对不计入耗时。
+ */
+static void runDeltaBenchmark(const Graph* g, const int* source_nodes, int n, int num_threads,
+                              int scaling, long long delta) {
+    if (delta <= 0) delta = deltaSteppingAutoDelta(g);
+    DijkstraContext* ref = createDijkstraContextWithQueue(g, PQ_BINARY);
+    if (ref == NULL) return;
+
+    // 线程数按倍数增长, 轮数不超过 int 的位数
+    DeltaSteppingContext* ctxs[32];
+    double total[32] = {0};
+    long long mismatches[32] = {0};
+    int rounds = 0;
+    for (int t = scaling ? 1 : num_threads; t != 0 && rounds < 32;
+         t = scaling ? batchNextThreadCount(t, num_threads) : 0) {
+        ctxs[rounds] = createDeltaSteppingContext(g, delta, t);
+        if (ctxs[rounds] == NULL) break;
+        rounds++;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        dijkstraRun(ref, source_nodes[i]);
+        for (int r = 0; r < rounds; ++r) {
+            DeltaSteppingContext* ctx = ctxs[r];
+            if (ctx == NULL) continue;
+            double start = graphNowSeconds();
+            if (deltaSteppingRun(ctx, source_nodes[i]) < 0) {
+                fprintf(stderr, "错误: %d 线程的 delta-stepping 查询失败。\n", ctx->numThreads);
+                deltaSteppingContextDestroy(ctx);
+                ctxs[r] = NULL;
+                continue;
+            }
+            total[r] += graphNowSeconds() - start;
+            for (int v = 1; v <= g->numVertices; ++v) {
+                if (deltaSteppingGetDist(ctx, v) != dijkstraGetDist(ref, v)) mismatches[r]++;
+            }
+        }
+    }
+
+    printf("\n--- Delta-stepping (delta = %lld) ---\n", delta);
+    printf("%8s %16s %10s %12s\n", "线程数", "平均延迟(毫秒)", "加速比", "距离不一致");
+    double base_ms = 0.0;
+    for (int r = 0; r < rounds; ++r) {
+        if (ctxs[r] == NULL) continue;
+        double ms = total[r] / n * 1000.0;
+        if (base_ms == 0.0) base_ms = ms;
+        printf("%8d %16.4f %10.2f %12lld\n", ctxs[r]->numThreads, ms, base_ms / ms, mismatches[r]);
+        deltaSteppingContextDestroy(ctxs[r]);
+    }
+    dijkstraContextDestroy(ref);
+}
+
+/**
+ * @brief 点对点查询: 单向 (终点确定即停止) 与双向 Dijkstra 对比确定顶点数和延迟
  */
-long long* dijkstra_fib_heap(Graph* g, int startNode) {
-    if (startNode <= 0 || startNode > g->numVertices) {
-        fprintf(stderr, "错误: 起始节点 %d 无效。\n", startNode);
-        return NULL;
+static void runPointToPointBenchmark(const Graph* g, PriorityQueueKind kind, const int* source_nodes,
+                                     const int* target_nodes, int n) {
+    DijkstraContext* uni = createDijkstraContextWithQueue(g, kind);
+    BidirectionalContext* bi = createBidirectionalContext(g, kind);
+    if (uni == NULL || bi == NULL) {
+        dijkstraContextDestroy(uni);
+        bidirectionalContextDestroy(bi);
+        return;
     }
 
-    // 1. 初始化
-    long long* dist = (long long*)malloc((g->numVertices + 1) * sizeof(long long));
-    if (dist == NULL) {
-        perror("错误: 无法为距离数组分配内存");
-        return NULL;
+    double uniTime = 0.0, biTime = 0.0;
+    long long uniSettled = 0, biSettled = 0;
+    int mismatches = 0;
+    for (int i = 0; i < n; ++i) {
+        double start = graphNowSeconds();
+        long long d1 = dijkstraPointToPoint(uni, source_nodes[i], target_nodes[i]);
+        double mid = graphNowSeconds();
+        long long d2 = dijkstraBidirectional(bi, source_nodes[i], target_nodes[i]);
+        biTime += graphNowSeconds() - mid;
+        uniTime += mid - start;
+        uniSettled += uni->numSettled;
+        biSettled += bi->numSettled;
+        if (d1 != d2) mismatches++;
     }
 
-    // 'nodePtrs' 用于存储从顶点ID到堆中节点的映射, 以便执行 decreaseKey
-    // 使用 calloc 自动初始化为 NULL
-    FibHeapNode** nodePtrs = (FibHeapNode**)calloc(g->numVertices + 1, sizeof(FibHeapNode*));
-    if (nodePtrs == NULL) {
-        perror("错误: 无法为节点指针数组分配内存");
+    printf("\n--- 点对点查询 (%s) ---\n", priorityQueueName(kind));
+    printf("%10s %18s %16s\n", "", "平均确定顶点数", "平均延迟(毫秒)");
+    printf("%10s %18.1f %16.4f\n", "单向", (double)uniSettled / n, uniTime / n * 1000.0);
+    printf("%10s %18.1f %16.4f\n", "双向", (double)biSettled / n, biTime / n * 1000.0);
+    printf("加速比: %.2f, 确定顶点数减少: %.1f%%, 距离不一致: %d\n",
+           biTime > 0 ? uniTime / biTime : 0.0,
+           uniSettled > 0 ? 100.0 * (1.0 - (double)biSettled / uniSettled) : 0.0, mismatches);
+
+    dijkstraContextDestroy(uni);
+    bidirectionalContextDestroy(bi);
+}
+
+/**
+ * @brief 随机点对: 一对多 Dijkstra 与目标集合查询 (终点全部确定即停止) 对比确定顶点数和延迟
+ *
+ * 每个起点随机选 k 个终点 (k = 1 即随机点对); 两种查询用同一个上下文, 逐个比对终点距离。
+ */
+static void runTargetSetBenchmark(const Graph* g, PriorityQueueKind kind, const int* source_nodes, int n,
+                                  int k, long long max_dist) {
+    DijkstraContext* ctx = createDijkstraContextWithQueue(g, kind);
+    int* targets = (int*)malloc(k * sizeof(int));
+    long long* dist = (long long*)malloc(k * sizeof(long long));
+    long long* expected = (long long*)malloc(k * sizeof(long long));
+    if (ctx == NULL || targets == NULL || dist == NULL || expected == NULL) {
+        dijkstraContextDestroy(ctx);
+        free(targets);
         free(dist);
-        return NULL;
+        free(expected);
+        return;
     }
 
-    for (int i = 0; i <= g->numVertices; ++i) {
-        dist[i] = INF;
+    double fullTime = 0.0, earlyTime = 0.0;
+    long long fullSettled = 0, earlySettled = 0;
+    long long mismatches = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < k; ++j) targets[j] = (rand() % g->numVertices) + 1;
+
+        double start = graphNowSeconds();
+        fullSettled += dijkstraRun(ctx, source_nodes[i]);
+        for (int j = 0; j < k; ++j) expected[j] = dijkstraGetDist(ctx, targets[j]);
+        double mid = graphNowSeconds();
+        earlySettled += dijkstraTargetSet(ctx, source_nodes[i], targets, k, max_dist, dist);
+        earlyTime += graphNowSeconds() - mid;
+        fullTime += mid - start;
+
+        for (int j = 0; j < k; ++j) {
+            long long want = (max_dist >= 0 && expected[j] > max_dist) ? DIJKSTRA_INF : expected[j];
+            if (dist[j] != want) mismatches++;
+        }
     }
 
-    // 2. 创建优先队列
-    FibHeap* pq = createFibHeap();
-    if (pq == NULL) {
-        free(dist);
-        free(nodePtrs);
-        return NULL;
-    }
-
-    // 3. 设置起始节点
-    dist[startNode] = 0;
-    nodePtrs[startNode] = fibHeapInsert(pq, 0, startNode);
-
-    // 4. Dijkstra主循环
-    while (!fibHeapIsEmpty(pq)) {
-        // 4.1 提取最小距离的顶点 u
-        int u = fibHeapExtractMin(pq);
-        nodePtrs[u] = NULL; // (关键!) 标记为已提取, 防止在 decreaseKey 中误用
-
-        if (dist[u] == INF) {
-            // 优化: 剩余节点不可达
-            break; 
-        }
-
-        // 4.2 遍历 u 的所有邻居 v
-        AdjListNode* current = g->adj[u];
-        while (current != NULL) {
-            int v = current->to;
-            int weight = current->weight;
-            
-            // 确保不会溢出
-            if (dist[u] == INF) {
-                current = current->next;
+    printf("\n--- 目标集合查询 (%s, 每个起点 %d 个终点", priorityQueueName(kind), k);
+    if (max_dist >= 0) printf(", 距离上限 %lld", max_dist);
+    printf(") ---\n");
+    printf("%10s %18s %16s\n", "", "平均确定顶点数", "平均延迟(毫秒)");
+    printf("%10s %18.1f %16.4f\n", "一对多", (double)fullSettled / n, fullTime / n * 1000.0);
+    printf("%10s %18.1f %16.4f\n", "提前停止", (double)earlySettled / n, earlyTime / n * 1000.0);
+    printf("加速比: %.2f, 确定顶点数减少: %.1f%%, 距离不一致: %lld\n",
+           earlyTime > 0 ? fullTime / earlyTime : 0.0,
+           fullSettled > 0 ? 100.0 * (1.0 - (double)earlySettled / fullSettled) : 0.0, mismatches);
+
+    dijkstraContextDestroy(ctx);
+    free(targets);
+    free(dist);
+    free(expected);
+}
+
+/**
+ * @brief 等时圈: 一对多 dijkstra_fib_heap 后扫描整个距离数组, 与有界查询直接返回半径内的顶点对比
+ *
+ * 两种方式用同一个上下文; 比对半径内的顶点数和每个顶点的距离。
+ */
+static void runRadiusBenchmark(const Graph* g, PriorityQueueKind kind, const int* source_nodes, int n,
+                               long long radius) {
+    DijkstraContext* ctx = createDijkstraContextWithQueue(g, kind);
+    long long* expected = (long long*)malloc((g->numVertices + 1) * sizeof(long long));
+    if (ctx == NULL || expected == NULL) {
+        dijkstraContextDestroy(ctx);
+        free(expected);
+        return;
+    }
+
+    double fullTime = 0.0, ballTime = 0.0;
+    long long ballSize = 0, ballSettled = 0;
+    long long mismatches = 0;
+    for (int i = 0; i < n; ++i) {
+        double start = graphNowSeconds();
+        dijkstraRun(ctx, source_nodes[i]);
+        int inside = 0;
+        for (int v = 1; v <= g->numVertices; ++v) {
+            long long d = dijkstraGetDist(ctx, v);
+            expected[v] = d;
+            if (d <= radius) inside++;
+        }
+        double mid = graphNowSeconds();
+        const DijkstraReached* reached = NULL;
+        int count = dijkstraWithinRadius(ctx, source_nodes[i], radius, &reached);
+        ballTime += graphNowSeconds() - mid;
+        fullTime += mid - start;
+        ballSettled += ctx->numSettled;
+
+        if (count != inside) mismatches++;
+        for (int j = 0; j < count; ++j) {
+            if (reached[j].dist != expected[reached[j].vertex]) mismatches++;
+        }
+        ballSize += count > 0 ? count : 0;
+    }
+
+    printf("\n--- 等时圈查询 (%s, 半径 %lld, 平均 %.1f 个顶点在半径内) ---\n", priorityQueueName(kind), radius,
+           (double)ballSize / n);
+    printf("%18s %18s %16s\n", "", "平均确定顶点数", "平均延迟(毫秒)");
+    printf("%18s %18d %16.4f\n", "一对多 + 扫描", g->numVertices, fullTime / n * 1000.0);
+    printf("%18s %18.1f %16.4f\n", "有界查询", (double)ballSettled / n, ballTime / n * 1000.0);
+    printf("加速比: %.2f, 结果缓冲区 %d 项 (跨查询复用), 不一致: %lld\n",
+           ballTime > 0 ? fullTime / ballTime : 0.0, ctx->reachedCapacity, mismatches);
+
+    dijkstraContextDestroy(ctx);
+    free(expected);
+}
+
+// 缓存模型重放的查询数 (每次需要按距离排序所有确定的顶点)
+#define REORDER_REPLAY_QUERIES 3
+
+typedef struct SettledVertex {
+    long long dist;
+    int vertex;
+} SettledVertex;
+
+static int compareSettled(const void* a, const void* b) {
+    const SettledVertex* x = (const SettledVertex*)a;
+    const SettledVertex* y = (const SettledVertex*)b;
+    if (x->dist != y->dist) return x->dist < y->dist ? -1 : 1;
+    return x->vertex - y->vertex;
+}
+
+/**
+ * @brief 按确定顺序 (距离升序) 重放最近一次查询对查询状态和 CSR 的访问, 喂给两级缓存模型
+ *
+ * 只模拟 state[u]、offsets[u]、targets[e] / weights[e] 和 state[v], 不含堆本身的访问。
+ */
+static void replayQuery(const DijkstraContext* ctx, CacheModel* l1, CacheModel* l2, SettledVertex* order) {
+    const Graph* g = ctx->g;
+    int count = 0;
+    for (int v = 1; v <= g->numVertices; ++v) {
+        long long d = dijkstraGetDist(ctx, v);
+        if (d == DIJKSTRA_INF) continue;
+        order[count].dist = d;
+        order[count].vertex = v;
+        count++;
+    }
+    qsort(order, count, sizeof(SettledVertex), compareSettled);
+
+#define TOUCH(addr) do { if (cacheModelAccess(l1, (addr))) cacheModelAccess(l2, (addr)); } while (0)
+    for (int i = 0; i < count; ++i) {
+        int u = order[i].vertex;
+        TOUCH(&ctx->state[u]);
+        TOUCH(&g->offsets[u]);
+        for (int e = g->offsets[u]; e < g->offsets[u + 1]; ++e) {
+            TOUCH(&g->targets[e]);
+            TOUCH(&g->weights[e]);
+            TOUCH(&ctx->state[g->targets[e]]);
+        }
+    }
+#undef TOUCH
+}
+
+/**
+ * @brief 顶点重新编号: 在原布局和 BFS / DFS / Hilbert 布局上执行同一批查询 (起点和结果都用原ID),
+ *        对比延迟、缓存缺失 (硬件计数器, 以及 32KB L1 + 1MB L2 的缓存模型) 并逐点比对距离
+ */
+static void runReorderBenchmark(const Graph* g, PriorityQueueKind kind, const int* source_nodes, int n,
+                                int all_orders, VertexOrder only) {
+    DijkstraContext* ref = createDijkstraContextWithQueue(g, kind);
+    CacheModel* l1 = createCacheModel(32 * 1024, 8);
+    CacheModel* l2 = createCacheModel(1024 * 1024, 16);
+    SettledVertex* order = (SettledVertex*)malloc((g->numVertices + 1) * sizeof(SettledVertex));
+    if (ref == NULL || l1 == NULL || l2 == NULL || order == NULL) {
+        dijkstraContextDestroy(ref);
+        cacheModelDestroy(l1);
+        cacheModelDestroy(l2);
+        free(order);
+        return;
+    }
+    CacheCounter counter;
+    int hardware = cacheCounterOpen(&counter) == 0;
+
+    printf("\n--- 顶点重新编号 (%s, %d 次查询) ---\n", priorityQueueName(kind), n);
+    if (!hardware) printf("硬件缓存计数器不可用 (perf_event_open), 只报告缓存模型\n");
+    printf("%10s %12s %12s %14s %8s %14s %14s %16s %8s\n", "布局", "预处理(秒)", "平均边跨度",
+           "平均延迟(毫秒)", "加速比", "L1缺失/顶点", "L2缺失/顶点", "缓存缺失/查询", "不一致");
+
+    double baseTime = 0.0;
+    for (int o = -1; o < VERTEX_ORDER_COUNT; ++o) {
+        if (o >= 0 && !all_orders && o != (int)only) continue;
+        if (o == VERTEX_ORDER_HILBERT && all_orders && g->coords == NULL) {
+            printf("%10s (需要 --co, 跳过)\n", vertexOrderName(VERTEX_ORDER_HILBERT));
+            continue;
+        }
+
+        // o == -1: 原布局
+        double start = graphNowSeconds();
+        VertexPermutation* p = NULL;
+        const Graph* layout = g;
+        Graph* permuted = NULL;
+        if (o >= 0) {
+            p = computeVertexOrder(g, (VertexOrder)o);
+            if (p == NULL) continue;
+            permuted = graphPermute(g, p);
+            if (permuted == NULL) {
+                vertexPermutationDestroy(p);
                 continue;
             }
+            layout = permuted;
+        }
+        double prepare = graphNowSeconds() - start;
+        DijkstraContext* ctx = createDijkstraContextWithQueue(layout, kind);
+        if (ctx == NULL) {
+            graphDestroy(permuted);
+            vertexPermutationDestroy(p);
+            continue;
+        }
 
-            long long newDist = dist[u] + weight;
+        double total = 0.0;
+        long long hwMisses = 0;
+        for (int i = 0; i < n; ++i) {
+            int s = p != NULL ? vertexToNew(p, source_nodes[i]) : source_nodes[i];
+            cacheCounterStart(&counter);
+            double t0 = graphNowSeconds();
+            dijkstraRun(ctx, s);
+            total += graphNowSeconds() - t0;
+            long long misses = cacheCounterStop(&counter);
+            if (misses > 0) hwMisses += misses;
+        }
 
-            // 4.3 松弛操作
-            if (newDist < dist[v]) {
-                dist[v] = newDist;
-                
-                if (nodePtrs[v] != NULL) {
-                    // 节点 v 已在堆中, 执行 decreaseKey
-                    fibHeapDecreaseKey(pq, nodePtrs[v], newDist);
-                } else {
-                    // 节点 v 首次被发现, 插入堆中
-                    nodePtrs[v] = fibHeapInsert(pq, newDist, v);
+        // 缓存模型与逐点比对只针对前几个起点, 不计入耗时
+        cacheModelReset(l1);
+        cacheModelReset(l2);
+        long long settled = 0;
+        long long mismatches = 0;
+        int replays = n < REORDER_REPLAY_QUERIES ? n : REORDER_REPLAY_QUERIES;
+        for (int i = 0; i < replays; ++i) {
+            int s = p != NULL ? vertexToNew(p, source_nodes[i]) : source_nodes[i];
+            settled += dijkstraRun(ctx, s);
+            replayQuery(ctx, l1, l2, order);
+            if (p != NULL) {
+                dijkstraRun(ref, source_nodes[i]);
+                for (int v = 1; v <= g->numVertices; ++v) {
+                    if (dijkstraGetDist(ref, v) != dijkstraGetDist(ctx, vertexToNew(p, v))) mismatches++;
                 }
             }
-            current = current->next;
+        }
+
+        if (o == -1) baseTime = total;
+        char hw[32];
+        if (hardware) {
+            snprintf(hw, sizeof(hw), "%.0f", (double)hwMisses / n);
+        } else {
+            snprintf(hw, sizeof(hw), "-");
+        }
+        printf("%10s %12.4f %12.1f %14.3f %8.2f %14.3f %14.3f %16s %8lld\n",
+               o >= 0 ? vertexOrderName((VertexOrder)o) : "原始", prepare, vertexOrderEdgeSpan(g, p),
+               total / n * 1000.0, total > 0 ? baseTime / total : 0.0,
+               settled > 0 ? (double)l1->misses / settled : 0.0,
+               settled > 0 ? (double)l2->misses / settled : 0.0, hw, mismatches);
+
+        dijkstraContextDestroy(ctx);
+        graphDestroy(permuted);
+        vertexPermutationDestroy(p);
+    }
+
+    cacheCounterClose(&counter);
+    dijkstraContextDestroy(ref);
+    cacheModelDestroy(l1);
+    cacheModelDestroy(l2);
+    free(order);
+}
+
+#define COMPRESS_VERIFY_QUERIES 3
+
+/**
+ * @brief 压缩邻接: 在原编号和 BFS 编号两种布局上, 对比 CSR 与压缩存储的每边字节数和一对多查询延迟,
+ *        前几个起点逐点比对距离 (起点和结果都用原ID)
+ */
+static void runCompressBenchmark(const Graph* g, PriorityQueueKind kind, const int* source_nodes, int n) {
+    DijkstraContext* ref = createDijkstraContextWithQueue(g, kind);
+    if (ref == NULL) return;
+    int m = g->numEdges > 0 ? g->numEdges : 1;
+    // CSR: offsets + targets + weights
+    size_t csrBytes = (size_t)(g->numVertices + 2) * sizeof(int) + (size_t)g->numEdges * 2 * sizeof(int);
+
+    printf("\n--- 压缩邻接 (%s, %d 次查询) ---\n", priorityQueueName(kind), n);
+    printf("%8s %10s %10s %12s %12s %10s %12s %14s %14s %8s %8s\n", "布局", "CSR字节/边", "压缩字节/边",
+           "流字节/边", "权重宽度", "压缩率", "构建(秒)", "CSR延迟(毫秒)", "压缩延迟(毫秒)", "减速比", "不一致");
+
+    for (int o = 0; o < 2; ++o) {
+        // o == 0: 原编号, o == 1: BFS 编号 (差值更小)
+        VertexPermutation* p = NULL;
+        Graph* permuted = NULL;
+        const Graph* layout = g;
+        if (o == 1) {
+            p = computeVertexOrder(g, VERTEX_ORDER_BFS);
+            if (p == NULL) break;
+            permuted = graphPermute(g, p);
+            if (permuted == NULL) {
+                vertexPermutationDestroy(p);
+                break;
+            }
+            layout = permuted;
+        }
+        double start = graphNowSeconds();
+        CompressedGraph* cg = compressGraph(layout);
+        double build = graphNowSeconds() - start;
+        DijkstraContext* csrCtx = createDijkstraContextWithQueue(layout, kind);
+        DijkstraContext* ctx = cg != NULL ? createCompressedDijkstraContext(cg, kind) : NULL;
+        if (cg == NULL || csrCtx == NULL || ctx == NULL) {
+            dijkstraContextDestroy(ctx);
+            dijkstraContextDestroy(csrCtx);
+            compressedGraphDestroy(cg);
+            graphDestroy(permuted);
+            vertexPermutationDestroy(p);
+            break;
+        }
+
+        double csrTime = 0.0;
+        double compressedTime = 0.0;
+        for (int i = 0; i < n; ++i) {
+            int s = p != NULL ? vertexToNew(p, source_nodes[i]) : source_nodes[i];
+            double t0 = graphNowSeconds();
+            dijkstraRun(csrCtx, s);
+            double t1 = graphNowSeconds();
+            compressedDijkstraRun(ctx, cg, s);
+            compressedTime += graphNowSeconds() - t1;
+            csrTime += t1 - t0;
+        }
+
+        // 逐点比对只针对前几个起点, 不计入耗时
+        long long mismatches = 0;
+        int checks = n < COMPRESS_VERIFY_QUERIES ? n : COMPRESS_VERIFY_QUERIES;
+        for (int i = 0; i < checks; ++i) {
+            int s = p != NULL ? vertexToNew(p, source_nodes[i]) : source_nodes[i];
+            dijkstraRun(ref, source_nodes[i]);
+            compressedDijkstraRun(ctx, cg, s);
+            for (int v = 1; v <= g->numVertices; ++v) {
+                int w = p != NULL ? vertexToNew(p, v) : v;
+                if (dijkstraGetDist(ref, v) != dijkstraGetDist(ctx, w)) mismatches++;
+            }
+        }
+
+        size_t bytes = compressedGraphBytes(cg);
+        printf("%8s %10.2f %10.2f %12.2f %12d %10.2f %12.4f %14.3f %14.3f %8.2f %8lld\n",
+               o == 0 ? "原始" : vertexOrderName(VERTEX_ORDER_BFS), (double)csrBytes / m, (double)bytes / m,
+               (double)cg->dataSize / m, cg->weightBytes, bytes > 0 ? (double)csrBytes / bytes : 0.0, build,
+               csrTime / n * 1000.0, compressedTime / n * 1000.0, csrTime > 0 ? compressedTime / csrTime : 0.0,
+               mismatches);
+
+        dijkstraContextDestroy(ctx);
+        dijkstraContextDestroy(csrCtx);
+        compressedGraphDestroy(cg);
+        graphDestroy(permuted);
+        vertexPermutationDestroy(p);
+    }
+    dijkstraContextDestroy(ref);
+}
+
+/**
+ * @brief 随机点对: A* 与普通 Dijkstra (终点确定即停止) 对比确定顶点数和延迟
+ */
+static void runAStarBenchmark(const Graph* g, PriorityQueueKind kind, AStarMetric metric, double scale,
+                              const int* source_nodes, const int* target_nodes, int n) {
+    DijkstraContext* plain = createDijkstraContextWithQueue(g, kind);
+    AStarContext* astar = createAStarContext(g, kind, metric, scale);
+    if (plain == NULL || astar == NULL) {
+        dijkstraContextDestroy(plain);
+        astarContextDestroy(astar);
+        return;
+    }
+
+    double plainTime = 0.0, astarTime = 0.0;
+    long long plainSettled = 0, astarSettled = 0;
+    int mismatches = 0;
+    for (int i = 0; i < n; ++i) {
+        double start = graphNowSeconds();
+        long long d1 = dijkstraPointToPoint(plain, source_nodes[i], target_nodes[i]);
+        double mid = graphNowSeconds();
+        long long d2 = astarQuery(astar, source_nodes[i], target_nodes[i]);
+        astarTime += graphNowSeconds() - mid;
+        plainTime += mid - start;
+        plainSettled += plain->numSettled;
+        astarSettled += astar->base->numSettled;
+        if (d1 != d2) mismatches++;
+    }
+
+    printf("\n--- A* 点对点查询 (%s) ---\n", priorityQueueName(kind));
+    printf("%10s %18s %16s\n", "", "平均确定顶点数", "平均延迟(毫秒)");
+    printf("%10s %18.1f %16.4f\n", "Dijkstra", (double)plainSettled / n, plainTime / n * 1000.0);
+    printf("%10s %18.1f %16.4f\n", "A*", (double)astarSettled / n, astarTime / n * 1000.0);
+    printf("加速比: %.2f, 确定顶点数减少: %.1f%%, 距离不一致: %d\n",
+           astarTime > 0 ? plainTime / astarTime : 0.0,
+           plainSettled > 0 ? 100.0 * (1.0 - (double)astarSettled / plainSettled) : 0.0, mismatches);
+
+    dijkstraContextDestroy(plain);
+    astarContextDestroy(astar);
+}
+
+/**
+ * @brief 随机点对: 使用前 j = 1, 2, 4, ..., k 个地标的 ALT 与普通 Dijkstra 对比
+ */
+static void runAltBenchmark(const Graph* g, PriorityQueueKind kind, const LandmarkSet* set,
+                            const int* source_nodes, const int* target_nodes, int n) {
+    DijkstraContext* plain = createDijkstraContextWithQueue(g, kind);
+    AltContext* alt = createAltContext(g, set, kind);
+    long long* expected = (long long*)malloc(n * sizeof(long long));
+    if (plain == NULL || alt == NULL || expected == NULL) {
+        dijkstraContextDestroy(plain);
+        altContextDestroy(alt);
+        free(expected);
+        return;
+    }
+
+    double plainTime = 0.0;
+    long long plainSettled = 0;
+    for (int i = 0; i < n; ++i) {
+        double start = graphNowSeconds();
+        expected[i] = dijkstraPointToPoint(plain, source_nodes[i], target_nodes[i]);
+        plainTime += graphNowSeconds() - start;
+        plainSettled += plain->numSettled;
+    }
+
+    printf("\n--- ALT 点对点查询 (%s) ---\n", priorityQueueName(kind));
+    printf("%10s %10s %18s %16s %8s %8s\n", "地标数", "文件(MB)", "平均确定顶点数", "平均延迟(毫秒)", "加速比", "不一致");
+    printf("%10s %10s %18.1f %16.4f %8s %8s\n", "Dijkstra", "-", (double)plainSettled / n, plainTime / n * 1000.0, "1.00", "-");
+
+    int k = set->numLandmarks;
+    for (int j = 1; j <= k; j = (j < k && j * 2 > k) ? k : j * 2) {
+        alt->numActive = j;
+        double total = 0.0;
+        long long settled = 0;
+        int mismatches = 0;
+        for (int i = 0; i < n; ++i) {
+            double start = graphNowSeconds();
+            long long d = altQuery(alt, source_nodes[i], target_nodes[i]);
+            total += graphNowSeconds() - start;
+            settled += alt->base->numSettled;
+            if (d != expected[i]) mismatches++;
+        }
+        printf("%10d %10.2f %18.1f %16.4f %8.2f %8d\n", j,
+               (double)landmarkFileSize(g->numVertices, j) / (1024.0 * 1024.0),
+               (double)settled / n, total / n * 1000.0, total > 0 ? plainTime / total : 0.0, mismatches);
+    }
+
+    dijkstraContextDestroy(plain);
+    altContextDestroy(alt);
+    free(expected);
+}
+
+/**
+ * @brief 随机点对: 收缩层次查询 (有 / 无 stall-on-demand) 与普通 Dijkstra 对比
+ */
+static void runChBenchmark(const Graph* g, PriorityQueueKind kind, const ContractionHierarchy* ch,
+                           const int* source_nodes, const int* target_nodes, int n) {
+    DijkstraContext* plain = createDijkstraContextWithQueue(g, kind);
+    ChQueryContext* qc = createChQueryContext(ch, kind);
+    long long* expected = (long long*)malloc(n * sizeof(long long));
+    if (plain == NULL || qc == NULL || expected == NULL) {
+        dijkstraContextDestroy(plain);
+        chQueryContextDestroy(qc);
+        free(expected);
+        return;
+    }
+
+    double plainTime = 0.0;
+    long long plainSettled = 0;
+    for (int i = 0; i < n; ++i) {
+        double start = graphNowSeconds();
+        expected[i] = dijkstraPointToPoint(plain, source_nodes[i], target_nodes[i]);
+        plainTime += graphNowSeconds() - start;
+        plainSettled += plain->numSettled;
+    }
+
+    printf("\n--- 收缩层次点对点查询 (%s) ---\n", priorityQueueName(kind));
+    printf("%14s %18s %16s %8s %8s\n", "", "平均确定顶点数", "平均延迟(微秒)", "加速比", "不一致");
+    printf("%14s %18.1f %16.2f %8s %8s\n", "Dijkstra", (double)plainSettled / n, plainTime / n * 1e6, "1.00", "-");
+    for (int stall = 0; stall <= 1; ++stall) {
+        qc->stallOnDemand = stall;
+        double total = 0.0;
+        long long settled = 0;
+        int mismatches = 0;
+        for (int i = 0; i < n; ++i) {
+            double start = graphNowSeconds();
+            long long d = chQuery(qc, source_nodes[i], target_nodes[i]);
+            total += graphNowSeconds() - start;
+            settled += qc->numSettled;
+            if (d != expected[i]) mismatches++;
+        }
+        printf("%14s %18.1f %16.2f %8.0f %8d\n", stall ? "CH (stall)" : "CH", (double)settled / n,
+               total / n * 1e6, total > 0 ? plainTime / total : 0.0, mismatches);
+    }
+
+    dijkstraContextDestroy(plain);
+    chQueryContextDestroy(qc);
+    free(expected);
+}
+
+/**
+ * @brief 一对多: dijkstra_fib_heap 与 PHAST (单源 / 多源) 对比, 逐点比对距离
+ */
+static void runPhastBenchmark(const Graph* g, const ContractionHierarchy* ch, const int* source_nodes, int n) {
+    double start = graphNowSeconds();
+    PhastEngine* pe = createPhastEngine(ch);
+    double setup = graphNowSeconds() - start;
+    DijkstraContext* ctx = createDijkstraContext(g);
+    if (pe == NULL || ctx == NULL) {
+        phastEngineDestroy(pe);
+        dijkstraContextDestroy(ctx);
+        return;
+    }
+
+    double fibTime = 0.0, phastTime = 0.0, multiTime = 0.0;
+    long long upSettled = 0;
+    long long mismatches = 0, multiMismatches = 0;
+    for (int i = 0; i < n; ++i) {
+        start = graphNowSeconds();
+        dijkstra_fib_heap(ctx, source_nodes[i]);
+        double mid = graphNowSeconds();
+        phastRun(pe, source_nodes[i]);
+        phastTime += graphNowSeconds() - mid;
+        fibTime += mid - start;
+        upSettled += pe->numSettledUp;
+        for (int v = 1; v <= g->numVertices; ++v) {
+            if (phastGetDist(pe, v) != dijkstraGetDist(ctx, v)) mismatches++;
+        }
+    }
+    for (int i = 0; i < n; i += PHAST_LANES) {
+        int count = n - i < PHAST_LANES ? n - i : PHAST_LANES;
+        start = graphNowSeconds();
+        phastRunMulti(pe, source_nodes + i, count);
+        multiTime += graphNowSeconds() - start;
+        for (int l = 0; l < count; ++l) {
+            dijkstraRun(ctx, source_nodes[i + l]);
+            for (int v = 1; v <= g->numVertices; ++v) {
+                if (phastGetLaneDist(pe, l, v) != dijkstraGetDist(ctx, v)) multiMismatches++;
+            }
         }
     }
 
-    // 5. 清理
-    // 注意: nodePtrs 中剩余的非NULL指针指向的节点
-    // 会在 fibHeapDestroy 中被统一释放
-    fibHeapDestroy(pq);
-    free(nodePtrs);
+    printf("\n--- PHAST 一对多查询 (重新编号 %.4f 秒, 向上搜索平均确定 %.1f 个顶点) ---\n",
+           setup, (double)upSettled / n);
+    printf("%22s %16s %8s %10s\n", "", "平均耗时(毫秒)", "加速比", "不一致");
+    printf("%22s %16.3f %8s %10s\n", "dijkstra_fib_heap", fibTime / n * 1000.0, "1.00", "-");
+    printf("%22s %16.3f %8.2f %10lld\n", "PHAST", phastTime / n * 1000.0,
+           phastTime > 0 ? fibTime / phastTime : 0.0, mismatches);
+    printf("%19s x%-2d %16.3f %8.2f %10lld\n", "PHAST", PHAST_LANES, multiTime / n * 1000.0,
+           multiTime > 0 ? fibTime / multiTime : 0.0, multiMismatches);
 
-    return dist; // 返回距离数组
+    phastEngineDestroy(pe);
+    dijkstraContextDestroy(ctx);
 }
 
 /**
  * @brief 主程序: 性能测试
- * * 编译: gcc -o test_fib main_fib.c Graph.c FibonacciHeap.c -std=c11 -O3 -lm
- * * 运行: ./test_fib <graph_file.txt> <n>
+ * * 编译: gcc -o test_fib main_fib.c Graph.c FibonacciHeap.c BinaryHeap.c RadixHeap.c PairingHeap.c DaryHeap.c IndexedFibHeap.c Dijkstra.c BatchQuery.c DeltaStepping.c AStar.c Landmarks.c ContractionHierarchy.c Phast.c VertexOrder.c CacheProbe.c CompressedGraph.c -std=c11 -O3 -lm -pthread
+ * * 运行: ./test_fib <graph_file> <n> [--co <coords.co>] [--threads <t>] [--scaling] [--heap <q>] [--delta <d|auto>] [--p2p]
+ *         [--astar <m>] [--alt <file.lmk>] [--ch <file.ch> [--phast]] [--pairs [--targets <k>] [--max-dist <d>]]
+ *         [--radius <r>] [--reorder <o>] [--compress]
  *
- * <graph_file.txt> 是 convert_format.c 的输出文件 ("id1 id2 距离")
+ * <graph_file> 可以是 convert_format.c 的输出文件 ("id1 id2 距离"),
+ * DIMACS .gr 原始文件 (直接读取, 无需转换),
+ * 或 convert_format -b 生成的二进制快照 (mmap 零拷贝加载)
  * <n> 是要测试的随机源节点数量
+ * --co 可选: 同时加载 DIMACS .co 坐标文件
+ * --threads 可选: 批量查询的线程数 (默认 1)
+ * --scaling 可选: 依次用 1, 2, 4, ..., t 个线程执行同一批查询, 报告扩展效率
+ * --heap 可选: 优先队列 fib (默认) | binary | radix | pairing | dary | fibidx | all (对同一批源点依次测试所有队列)
+ * --delta 可选: 改为测试 delta-stepping (单个查询用 t 个线程并行), 参数为桶宽或 auto
+ * --p2p 可选: 改为测试 n 个随机点对的点对点查询 (构建反向图, 对比单向与双向 Dijkstra)
+ * --astar 可选: 改为测试 n 个随机点对的 A* 查询 (需要 --co), 下界为 auto | euclidean | great-circle
+ * --alt 可选: 改为测试 n 个随机点对的 ALT 查询, 地标文件由 build_landmarks 生成
+ * --ch 可选: 改为测试 n 个随机点对的收缩层次查询, 层次文件由 build_ch 生成
+ * --phast 可选 (需要 --ch): 改为测试 n 个起点的 PHAST 一对多查询, 与 dijkstra_fib_heap 对比
+ * --pairs 可选: 改为测试 n 个起点的目标集合查询, 与一对多 Dijkstra 对比延迟
+ * --targets 可选 (需要 --pairs): 每个起点的随机终点数 (默认 1, 即随机点对)
+ * --max-dist 可选 (需要 --pairs): 距离上限 (默认不限)
+ * --radius 可选: 改为测试 n 个起点的等时圈查询 (只返回距离不超过 r 的顶点), 与一对多 + 扫描对比
+ * --reorder 可选: 改为对比原布局与按 bfs | dfs | hilbert | all 重新编号后的布局 (延迟与缓存缺失)
+ * --compress 可选: 改为对比 CSR 与压缩邻接存储 (每边字节数与一对多查询的减速比)
  */
 int main(int argc, char* argv[]) {
     // 检查命令行参数
-    if (argc != 3) {
+    if (argc < 3) {
         fprintf(stderr, "错误: 参数数量不正确。\n");
-        fprintf(stderr, "用法: %s <graph_file.txt> <n>\n", argv[0]);
+        fprintf(stderr, "用法: %s <graph_file> <n> [--co <coords.co>] [--threads <t>] [--scaling] [--heap <q>] [--delta <d|auto>] [--p2p] [--astar <m>] [--alt <file.lmk>] [--ch <file.ch> [--phast]] [--pairs [--targets <k>] [--max-dist <d>]] [--radius <r>] [--reorder <o>] [--compress]\n", argv[0]);
+        fprintf(stderr, "  <graph_file>: 文本边列表, DIMACS .gr 或二进制快照\n");
         fprintf(stderr, "  <n>: 要测试的随机查询次数 (例如: 1000)\n");
+        fprintf(stderr, "  --co: 可选的 DIMACS 坐标文件\n");
+        fprintf(stderr, "  --threads: 批量查询线程数 (默认 1)\n");
+        fprintf(stderr, "  --scaling: 测试 1 到 t 个线程的扩展效率\n");
+        fprintf(stderr, "  --heap: 优先队列 fib | binary | radix | pairing | dary | fibidx | all (默认 fib)\n");
+        fprintf(stderr, "  --delta: 测试并行 delta-stepping, 桶宽为 d 或 auto (按边权分布选择)\n");
+        fprintf(stderr, "  --p2p: 测试随机点对查询, 对比单向与双向 Dijkstra\n");
+        fprintf(stderr, "  --astar: 测试 A* 点对点查询 (需要 --co), 下界 auto | euclidean | great-circle\n");
+        fprintf(stderr, "  --alt: 测试 ALT 点对点查询, 地标文件由 build_landmarks 生成\n");
+        fprintf(stderr, "  --ch: 测试收缩层次点对点查询, 层次文件由 build_ch 生成\n");
+        fprintf(stderr, "  --phast: 与 --ch 一起使用, 测试 PHAST 一对多查询\n");
+        fprintf(stderr, "  --pairs: 随机点对模式, 对比一对多与目标集合查询 (终点确定即停止)\n");
+        fprintf(stderr, "  --targets: 与 --pairs 一起使用, 每个起点的终点数 (默认 1)\n");
+        fprintf(stderr, "  --max-dist: 与 --pairs 一起使用, 距离上限 (默认不限)\n");
+        fprintf(stderr, "  --radius: 测试等时圈查询, 只返回距离不超过 r 的顶点\n");
+        fprintf(stderr, "  --reorder: 测试顶点重新编号 bfs | dfs | hilbert (需要 --co) | all\n");
+        fprintf(stderr, "  --compress: 测试压缩邻接存储 (差值 + varint 编码), 对比内存与查询延迟\n");
         return 1;
     }
 
     const char* graph_filename = argv[1];
     int n = atoi(argv[2]); // 将字符串参数转为整数
+    const char* coord_filename = NULL;
+    int num_threads = 1;
+    int scaling = 0;
+    int all_queues = 0;
+    PriorityQueueKind kind = PQ_FIBONACCI;
+    int delta_mode = 0;
+    long long delta = 0; // 0: 自动选择
+    int p2p_mode = 0;
+    int astar_mode = 0;
+    AStarMetric metric = ASTAR_METRIC_AUTO;
+    const char* landmark_filename = NULL;
+    const char* ch_filename = NULL;
+    int phast_mode = 0;
+    int pairs_mode = 0;
+    int pair_targets = 1;
+    long long max_dist = -1; // < 0: 不限
+    long long radius = -1;   // < 0: 不测试等时圈
+    int reorder_mode = 0;
+    int all_orders = 0;
+    VertexOrder vertex_order = VERTEX_ORDER_BFS;
+    int compress_mode = 0;
+
+    // 可选参数
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--co") == 0 && i + 1 < argc) {
+            coord_filename = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scaling") == 0) {
+            scaling = 1;
+        } else if (strcmp(argv[i], "--heap") == 0 && i + 1 < argc) {
+            const char* key = argv[++i];
+            if (strcmp(key, "all") == 0) {
+                all_queues = 1;
+            } else if (priorityQueueParse(key, &kind) != 0) {
+                fprintf(stderr, "错误: 未知的优先队列 '%s'。\n", key);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--p2p") == 0) {
+            p2p_mode = 1;
+        } else if (strcmp(argv[i], "--astar") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            astar_mode = 1;
+            if (strcmp(name, "auto") == 0) {
+                metric = ASTAR_METRIC_AUTO;
+            } else if (strcmp(name, "euclidean") == 0) {
+                metric = ASTAR_METRIC_EUCLIDEAN;
+            } else if (strcmp(name, "great-circle") == 0) {
+                metric = ASTAR_METRIC_GREAT_CIRCLE;
+            } else {
+                fprintf(stderr, "错误: 未知的下界 '%s'。\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--alt") == 0 && i + 1 < argc) {
+            landmark_filename = argv[++i];
+        } else if (strcmp(argv[i], "--ch") == 0 && i + 1 < argc) {
+            ch_filename = argv[++i];
+        } else if (strcmp(argv[i], "--phast") == 0) {
+            phast_mode = 1;
+        } else if (strcmp(argv[i], "--pairs") == 0) {
+            pairs_mode = 1;
+        } else if (strcmp(argv[i], "--targets") == 0 && i + 1 < argc) {
+            pair_targets = atoi(argv[++i]);
+            if (pair_targets <= 0) {
+                fprintf(stderr, "错误: 终点数必须是正整数。\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--reorder") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            reorder_mode = 1;
+            if (strcmp(name, "all") == 0) {
+                all_orders = 1;
+            } else if (vertexOrderParse(name, &vertex_order) != 0) {
+                fprintf(stderr, "错误: 未知的顶点顺序 '%s'。\n", name);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--compress") == 0) {
+            compress_mode = 1;
+        } else if (strcmp(argv[i], "--radius") == 0 && i + 1 < argc) {
+            radius = atoll(argv[++i]);
+            if (radius < 0) {
+                fprintf(stderr, "错误: 半径不能为负数。\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--max-dist") == 0 && i + 1 < argc) {
+            max_dist = atoll(argv[++i]);
+            if (max_dist < 0) {
+                fprintf(stderr, "错误: 距离上限不能为负数。\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--delta") == 0 && i + 1 < argc) {
+            const char* value = argv[++i];
+            delta_mode = 1;
+            delta = strcmp(value, "auto") == 0 ? 0 : atoll(value);
+            if (delta <= 0 && strcmp(value, "auto") != 0) {
+                fprintf(stderr, "错误: 桶宽必须是正整数或 auto。\n");
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "错误: 未知参数 '%s'。\n", argv[i]);
+            return 1;
+        }
+    }
 
     if (n <= 0) {
         fprintf(stderr, "错误: 查询次数 'n' 必须是正整数。\n");
         return 1;
     }
+    if (num_threads <= 0) {
+        fprintf(stderr, "错误: 线程数必须是正整数。\n");
+        return 1;
+    }
 
     // --- 1. 加载图 ---
-    Graph* g = loadGraphFromFile(graph_filename);
+    Graph* g = loadGraph(graph_filename);
     if (g == NULL) {
         fprintf(stderr, "错误: 图加载失败。\n");
         return 1;
     }
+    if (coord_filename != NULL && graphLoadCoordinates(g, coord_filename) != 0) {
+        fprintf(stderr, "警告: 坐标文件加载失败, 继续测试。\n");
+    }
+    if (p2p_mode) {
+        // 双向搜索的后向部分在反向图上运行
+        double start = graphNowSeconds();
+        if (graphBuildReverse(g) != 0) {
+            graphDestroy(g);
+            return 1;
+        }
+        printf("反向图构建耗时: %.4f 秒\n", graphNowSeconds() - start);
+    }
 
     // --- 2. 准备查询 ---
     printf("\n正在生成 %d 个随机源节点用于测试...\n", n);
     
     int* source_nodes = (int*)malloc(n * sizeof(int));
-    if (source_nodes == NULL) {
+    int* target_nodes = (int*)malloc(n * sizeof(int));
+    if (source_nodes == NULL || target_nodes == NULL) {
         perror("错误: 无法为源节点数组分配内存");
+        free(source_nodes);
+        free(target_nodes);
         graphDestroy(g);
         return 1;
     }
@@ -153,45 +933,89 @@ int main(int argc, char* argv[]) {
     for (int i = 0; i < n; ++i) {
         // 生成 [1, g->numVertices] 范围内的随机ID
         source_nodes[i] = (rand() % g->numVertices) + 1;
+        target_nodes[i] = (rand() % g->numVertices) + 1; // 仅点对点模式使用
     }
 
     // --- 3. 执行性能测试 ---
-    printf("开始性能测试 (Dijkstra + Fibonacci Heap)...\n");
-    
-    // 使用 <time.h> 中的 clock() 计时
-    clock_t start_time = clock();
-
-    for (int i = 0; i < n; ++i) {
-        int startNode = source_nodes[i];
-        
-        // 调用Dijkstra算法
-        long long* distances = dijkstra_fib_heap(g, startNode);
-
-        if (distances != NULL) {
-            // 必须释放dijkstra返回的距离数组
-            free(distances);
-        } else {
-             fprintf(stderr, "警告: 第 %d 次查询 (源: %d) 失败。\n", i+1, startNode);
+    if (ch_filename != NULL) {
+        double start = graphNowSeconds();
+        ContractionHierarchy* ch = chLoad(ch_filename, g);
+        if (ch != NULL) {
+            printf("收缩层次: %s (%.2f MB, 加载 %.4f 秒), 向上边 %d 条, 向下边 %d 条\n", ch_filename,
+                   (double)chFileSize(ch) / (1024.0 * 1024.0), graphNowSeconds() - start,
+                   ch->upward->numEdges, ch->downward->numEdges);
+            if (phast_mode) {
+                runPhastBenchmark(g, ch, source_nodes, n);
+            } else {
+                for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+                    if (!all_queues && q != (int)kind) continue;
+                    runChBenchmark(g, (PriorityQueueKind)q, ch, source_nodes, target_nodes, n);
+                }
+            }
+            chDestroy(ch);
+        }
+    } else if (landmark_filename != NULL) {
+        LandmarkSet* set = landmarkLoad(landmark_filename, g);
+        if (set != NULL) {
+            printf("地标: %d 个 (%s), %s\n", set->numLandmarks, landmarkSelectionName(set->selection), landmark_filename);
+            for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+                if (!all_queues && q != (int)kind) continue;
+                runAltBenchmark(g, (PriorityQueueKind)q, set, source_nodes, target_nodes, n);
+            }
+            landmarkSetDestroy(set);
+        }
+    } else if (astar_mode) {
+        // 所有队列共用一次标定
+        AStarMetric resolved;
+        double scale = astarCalibrateScale(g, metric, &resolved);
+        if (scale >= 0.0) {
+            printf("A* 下界: %s, 系数 %.6g (权重 / 几何距离的最小值)\n", astarMetricName(resolved), scale);
+            for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+                if (!all_queues && q != (int)kind) continue;
+                runAStarBenchmark(g, (PriorityQueueKind)q, resolved, scale, source_nodes, target_nodes, n);
+            }
+        }
+    } else if (reorder_mode) {
+        for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+            if (!all_queues && q != (int)kind) continue;
+            runReorderBenchmark(g, (PriorityQueueKind)q, source_nodes, n, all_orders, vertex_order);
+        }
+    } else if (compress_mode) {
+        for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+            if (!all_queues && q != (int)kind) continue;
+            runCompressBenchmark(g, (PriorityQueueKind)q, source_nodes, n);
+        }
+    } else if (radius >= 0) {
+        for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+            if (!all_queues && q != (int)kind) continue;
+            runRadiusBenchmark(g, (PriorityQueueKind)q, source_nodes, n, radius);
         }
-        
-        // (可选) 打印进度
-        // if ((i + 1) % 100 == 0) {
-        //     printf("已完成 %d / %d 次查询...\n", i + 1, n);
-        // }
+    } else if (pairs_mode) {
+        for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+            if (!all_queues && q != (int)kind) continue;
+            runTargetSetBenchmark(g, (PriorityQueueKind)q, source_nodes, n, pair_targets, max_dist);
+        }
+    } else if (p2p_mode) {
+        for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+            if (!all_queues && q != (int)kind) continue;
+            runPointToPointBenchmark(g, (PriorityQueueKind)q, source_nodes, target_nodes, n);
+        }
+    } else if (delta_mode) {
+        printf("开始性能测试 (Delta-stepping, 查询内并行)...\n");
+        runDeltaBenchmark(g, source_nodes, n, num_threads, scaling, delta);
+    } else if (all_queues) {
+        for (int q = 0; q < PQ_KIND_COUNT; ++q) {
+            printf("开始性能测试 (Dijkstra + %s)...\n", priorityQueueName((PriorityQueueKind)q));
+            runBenchmark(g, (PriorityQueueKind)q, source_nodes, n, num_threads, scaling);
+        }
+    } else {
+        printf("开始性能测试 (Dijkstra + %s)...\n", priorityQueueName(kind));
+        runBenchmark(g, kind, source_nodes, n, num_threads, scaling);
     }
 
-    clock_t end_time = clock();
-    
-    // --- 4. 输出结果 ---
-    double time_spent_seconds = (double)(end_time - start_time) / CLOCKS_PER_SEC;
-
-    printf("\n--- 性能测试结果 (Fibonacci Heap) ---\n");
-    printf("总共执行查询: %d\n", n);
-    printf("总耗时: %.4f 秒\n", time_spent_seconds);
-    printf("平均每次查询耗时: %.4f 毫秒\n", (time_spent_seconds / n) * 1000.0);
-
-    // --- 5. 最终清理 ---
+    // --- 4. 最终清理 ---
     free(source_nodes);
+    free(target_nodes);
     graphDestroy(g);
 
     return 0; // 成功退出
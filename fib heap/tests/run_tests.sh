@@ -0,0 +1,29 @@
+#!/bin/sh
+# 回归用例: 在 "fib heap" 目录下运行 sh tests/run_tests.sh
+# 用 -fsanitize=address 编译 test_fib (编译器不支持时退回普通编译), 逐个加载 tests/ 中的图并检查边数。
+set -u
+cd "$(dirname "$0")/.." || exit 1
+BIN=tests/test_fib_asan
+SRC="main_fib.c Graph.c FibonacciHeap.c BinaryHeap.c RadixHeap.c PairingHeap.c DaryHeap.c IndexedFibHeap.c Dijkstra.c BatchQuery.c DeltaStepping.c AStar.c Landmarks.c ContractionHierarchy.c Phast.c VertexOrder.c CacheProbe.c CompressedGraph.c"
+gcc -g -O1 -fsanitize=address -o "$BIN" $SRC -std=c11 -lm -pthread 2>/dev/null ||
+    gcc -O2 -o "$BIN" $SRC -std=c11 -lm -pthread || exit 1
+
+failures=0
+# 用法: check <图文件> <期望边数>
+check() {
+    out=$("$BIN" "$1" 1 2>&1)
+    status=$?
+    if [ $status -ne 0 ] || ! printf '%s\n' "$out" | grep -q "总边数: $2\$" ||
+       printf '%s\n' "$out" | grep -q "ERROR: AddressSanitizer\|ERROR: LeakSanitizer\|顶点ID"; then
+        echo "FAIL $1"
+        printf '%s\n' "$out" | tail -20
+        failures=$((failures + 1))
+    else
+        echo "ok   $1"
+    fi
+}
+
+check tests/dimacs_header_after_arcs.gr 2
+
+rm -f "$BIN"
+[ $failures -eq 0 ]